@@ -0,0 +1,87 @@
+#ifndef ACTOR_HASH_H
+#define ACTOR_HASH_H
+
+#include <gbdk/platform.h>
+#include "gbs_types.h"
+#include "actor.h"
+
+// 32px cells: positions are in 1/16 px, so a cell is pos >> 9
+#define ACTOR_HASH_CELL_SHIFT 9
+#define ACTOR_HASH_CELL_PX_SHIFT 5
+
+// 8x8 cells (256x256 px) before buckets alias, which covers a screen plus margin
+#define ACTOR_HASH_ROW_SHIFT 3
+#define ACTOR_HASH_BUCKETS 64
+// Actors whose bounds reach further than ACTOR_HASH_REACH px from their
+// position are kept in an extra bucket that every query visits
+#define ACTOR_HASH_OVERSIZE ACTOR_HASH_BUCKETS
+#define ACTOR_HASH_REACH 16
+// Movement allowed between the per-frame refresh and a query (scripts run before actors_update)
+#define ACTOR_HASH_SLACK 8
+// Queries spanning more cells than this walk the active list instead
+#define ACTOR_HASH_MAX_QUERY_CELLS 9
+
+#define ACTOR_HASH_NONE 0xFF
+#define ACTOR_HASH_SCAN_ALL 0xFF
+
+#define ACTOR_HASH_BUCKET_OF(cx, cy) (((cx) + ((cy) << ACTOR_HASH_ROW_SHIFT)) & (ACTOR_HASH_BUCKETS - 1))
+
+extern UBYTE actor_hash_head[ACTOR_HASH_BUCKETS + 1];
+extern UBYTE actor_hash_next[MAX_ACTORS];
+extern UBYTE actor_hash_bucket[MAX_ACTORS];
+extern UBYTE actor_hash_candidates[MAX_ACTORS];
+// Collision groups of all active, collision enabled actors as of the last refresh
+extern UBYTE actor_hash_groups;
+
+/**
+ * Bucket an actor belongs in for its current position and bounds.
+ *
+ * @param actor Actor to hash
+ * @return Bucket index, ACTOR_HASH_OVERSIZE for actors with large bounds
+ */
+inline UBYTE actor_hash_bucket_of(actor_t *actor) {
+    if ((actor->bounds.left < -ACTOR_HASH_REACH) || (actor->bounds.right > ACTOR_HASH_REACH) ||
+        (actor->bounds.top < -ACTOR_HASH_REACH) || (actor->bounds.bottom > ACTOR_HASH_REACH)) {
+        return ACTOR_HASH_OVERSIZE;
+    }
+    return ACTOR_HASH_BUCKET_OF((UBYTE)(actor->pos.x >> ACTOR_HASH_CELL_SHIFT), (UBYTE)(actor->pos.y >> ACTOR_HASH_CELL_SHIFT));
+}
+
+// Empty every bucket
+void actor_hash_init(void) BANKED;
+
+// Add an actor to the bucket of its current position (moves it if already hashed)
+void actor_hash_insert(actor_t *actor) BANKED;
+
+// Remove an actor from its bucket
+void actor_hash_remove(actor_t *actor) BANKED;
+
+// Move every active actor whose cell changed since the last call; run once per frame
+void actor_hash_update(void) BANKED;
+
+/**
+ * Collect actors hashed into the cells overlapping a pixel rectangle.
+ * Candidates are written to actor_hash_candidates as indices into actors[]
+ * and still need an exact bounds test; they may include inactive actors.
+ *
+ * @param x0 Left edge in pixels
+ * @param y0 Top edge in pixels
+ * @param x1 Right edge in pixels
+ * @param y1 Bottom edge in pixels
+ * @return Candidate count, or ACTOR_HASH_SCAN_ALL if the area is too large
+ */
+UBYTE actor_hash_query(WORD x0, WORD y0, WORD x1, WORD y1) BANKED;
+
+/**
+ * Find a collision enabled actor in one of the given collision groups
+ * overlapping a positioned bounding box. Actors outside the mask are
+ * skipped before the bounds test, so they never shadow one that matches.
+ *
+ * @param bb Pointer to bounding box
+ * @param offset Pointer to position offset for bounding box
+ * @param mask Collision groups that can be hit
+ * @return Overlapping actor, NULL if none
+ */
+actor_t *actor_hash_overlapping_group(bounding_box_t *bb, point16_t *offset, UBYTE mask) BANKED;
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef ACTOR_LINES_H
+#define ACTOR_LINES_H
+
+#include <gbdk/platform.h>
+#include "gbs_types.h"
+#include "actor.h"
+
+// Inactive actors are bucketed by tile row and by left tile column so the
+// scroller only tests actors in the lines it reveals. Buckets wrap every 32 tiles.
+#define ACTOR_LINES_BUCKETS 32
+// Actors reaching more than this many px right of their position can cover
+// columns left of their own bucket, so they sit in an extra bucket every column visits
+#define ACTOR_LINES_REACH 15
+#define ACTOR_LINES_WIDE ACTOR_LINES_BUCKETS
+// Columns left of the revealed one whose actors may still reach it
+#define ACTOR_LINES_COL_SPAN (((ACTOR_LINES_REACH + 7) >> 3) + 1)
+
+#define ACTOR_LINES_NONE 0xFF
+
+extern UBYTE actor_lines_row_head[ACTOR_LINES_BUCKETS];
+extern UBYTE actor_lines_row_next[MAX_ACTORS];
+extern UBYTE actor_lines_col_head[ACTOR_LINES_BUCKETS + 1];
+extern UBYTE actor_lines_col_next[MAX_ACTORS];
+// Set on scene load, deactivation and script moves of inactive actors;
+// the next reveal rebuilds the buckets once and clears it
+extern UBYTE actor_lines_stale;
+
+// Empty every bucket
+void actor_lines_init(void) BANKED;
+
+// Unlink an actor that has just been activated
+void actor_lines_remove(actor_t *actor) BANKED;
+
+// Relink every inactive scene actor into the buckets of its current tile
+void actor_lines_refresh(void) BANKED;
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef CPU_METER_H
+#define CPU_METER_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "data/states_defines.h"
+
+#ifndef CPU_METER
+#define CPU_METER 0
+#endif
+
+// Stages sampled by the meter (the level code stage runs inside the VM stage)
+#define CPU_METER_STAGE_VM          0
+#define CPU_METER_STAGE_SCROLL      1
+#define CPU_METER_STAGE_ACTORS      2
+#define CPU_METER_STAGE_PROJECTILES 3
+#define CPU_METER_STAGE_LEVEL_CODE  4
+#define CPU_METER_STAGE_TOTAL       5
+#define CPU_METER_STAGE_COUNT       6
+
+// Number of frames kept in the ring buffer (must be a power of 2)
+#define CPU_METER_HISTORY 8
+
+// 144 visible + 10 vblank lines; sys_time ticks at LY 144
+#define CPU_METER_LINES_PER_FRAME 154
+#define CPU_METER_VBL_LINE 144
+
+// Window row the bar is drawn on, and CGB palettes used per load band
+#define CPU_METER_BAR_ROW 0
+#define CPU_METER_BAR_WIDTH 20
+#define CPU_METER_PAL_LOW 7
+#define CPU_METER_PAL_HIGH 6
+#define CPU_METER_PAL_OVER 5
+
+#if CPU_METER
+
+extern UBYTE cpu_meter_start_line[CPU_METER_STAGE_COUNT];
+extern UBYTE cpu_meter_start_frame[CPU_METER_STAGE_COUNT];
+extern UWORD cpu_meter_accum[CPU_METER_STAGE_COUNT];
+extern UWORD cpu_meter_history[CPU_METER_HISTORY][CPU_METER_STAGE_COUNT];
+extern UBYTE cpu_meter_head;
+extern UBYTE cpu_meter_bar_enabled;
+
+/**
+ * Mark the start of a stage. Lines are counted from the vblank edge so
+ * that a stage straddling LY 153 -> 0 is measured correctly.
+ *
+ * @param stage Stage index (CPU_METER_STAGE_*)
+ */
+inline void cpu_meter_begin(UBYTE stage) {
+    cpu_meter_start_frame[stage] = (UBYTE)sys_time;
+    cpu_meter_start_line[stage] = LY_REG;
+}
+
+/**
+ * Mark the end of a stage and add its scanline cost to the current frame.
+ *
+ * @param stage Stage index (CPU_METER_STAGE_*)
+ */
+inline void cpu_meter_end(UBYTE stage) {
+    UBYTE line = LY_REG;
+    UBYTE frames = (UBYTE)sys_time - cpu_meter_start_frame[stage];
+    UBYTE start = cpu_meter_start_line[stage];
+    // rebase both samples on the vblank edge where sys_time ticks
+    line = (line >= CPU_METER_VBL_LINE) ? (line - CPU_METER_VBL_LINE) : (line + (CPU_METER_LINES_PER_FRAME - CPU_METER_VBL_LINE));
+    start = (start >= CPU_METER_VBL_LINE) ? (start - CPU_METER_VBL_LINE) : (start + (CPU_METER_LINES_PER_FRAME - CPU_METER_VBL_LINE));
+    cpu_meter_accum[stage] += ((UWORD)frames * CPU_METER_LINES_PER_FRAME) + line - start;
+}
+
+#define CPU_METER_BEGIN(stage) cpu_meter_begin(stage)
+#define CPU_METER_END(stage) cpu_meter_end(stage)
+
+#else
+
+#define CPU_METER_BEGIN(stage)
+#define CPU_METER_END(stage)
+
+#endif
+
+// Clear the ring buffer and hide the bar
+void cpu_meter_init(void) BANKED;
+
+// Close the current frame: push accumulated costs into the ring and redraw the bar
+void cpu_meter_frame_end(void) BANKED;
+
+// Script access: copy the last N costs of a stage into consecutive variables
+void vm_cpu_meter_get_costs(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+// Script access: show or hide the CPU bar on the window layer
+void vm_cpu_meter_show_bar(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
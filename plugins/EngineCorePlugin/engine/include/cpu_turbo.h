@@ -0,0 +1,49 @@
+#ifndef CPU_TURBO_H
+#define CPU_TURBO_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "data/states_defines.h"
+
+// Always: stock behaviour, CGB runs in double speed from boot.
+// Sections: CGB runs at normal speed and only switches up inside turbo sections
+#define CGB_CPU_SPEED_ALWAYS 0
+#define CGB_CPU_SPEED_SECTIONS 1
+
+#ifndef CGB_CPU_SPEED
+#define CGB_CPU_SPEED CGB_CPU_SPEED_ALWAYS
+#endif
+
+// Open engine sections (load_scene, editor rebuilds); nest freely
+extern UBYTE cpu_turbo_depth;
+// Holders that keep double speed on across frames, cleared on scene change
+#define CPU_TURBO_HOLD_SCRIPT 0x01
+#define CPU_TURBO_HOLD_JOB 0x02
+extern UBYTE cpu_turbo_held;
+
+// music_setup_timer() clocks the timer at 16384Hz (TAC 0x07), 32768Hz in double speed,
+// so overflows stay at 256Hz: 64 counts at normal speed, 128 in double speed
+#define CPU_TURBO_TMA ((_is_CGB && (KEY1_REG & 0x80)) ? 0x80u : 0xC0u)
+
+// Replaces the cpu_fast() call in core_run()
+void cpu_turbo_init(void) BANKED;
+
+// Drop sections left open by jobs and scripts of the previous scene, without switching speed
+void cpu_turbo_reset(void) BANKED;
+
+// Run the following code in double speed on CGB; no effect on DMG
+void cpu_turbo_begin(void) BANKED;
+void cpu_turbo_end(void) BANKED;
+
+/**
+ * Keep double speed on across frames until released or the scene changes.
+ * Holding twice is the same as holding once.
+ *
+ * @param holder CPU_TURBO_HOLD_SCRIPT or CPU_TURBO_HOLD_JOB
+ * @param hold TRUE to hold, FALSE to release
+ */
+void cpu_turbo_hold(UBYTE holder, UBYTE hold) BANKED;
+
+void vm_cpu_turbo_hold(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef FLASH_JOURNAL_H
+#define FLASH_JOURNAL_H
+
+#include <gbdk/platform.h>
+
+// The save sector erased by erase_flash() spans four ROM banks from _start_save.
+// SRAM mirrors take the first two (two SRAM banks per ROM bank), the journal the rest
+#define FLASH_JOURNAL_FIRST_BANK 2
+#define FLASH_JOURNAL_BANKS 2
+
+// Record: SRAM bank, offset (LE), length, payload, commit byte written last.
+// Erased flash reads 0xFF, so an 0xFF bank byte ends the log
+#define FLASH_JOURNAL_HEADER_SIZE 4
+#define FLASH_JOURNAL_CHUNK 32
+#define FLASH_JOURNAL_RECORD_SIZE(len) (FLASH_JOURNAL_HEADER_SIZE + (len) + 1)
+#define FLASH_JOURNAL_END 0xFF
+#define FLASH_JOURNAL_COMMIT 0x00
+
+// Next free record: journal bank (0 based) and address within it
+extern UBYTE flash_journal_bank;
+extern UBYTE *flash_journal_ptr;
+// Set when replay found a torn record; the next write compacts first
+extern UBYTE flash_journal_broken;
+
+// Arguments of flash_program(), kept in WRAM so the routine can run with SRAM off
+extern UBYTE flash_prog_bank;
+extern UBYTE *flash_prog_dest;
+extern const UBYTE *flash_prog_src;
+extern UBYTE flash_prog_len;
+
+/**
+ * Program flash_prog_len bytes from WRAM at flash_prog_src to erased flash
+ * at flash_prog_dest in ROM bank flash_prog_bank.
+ *
+ * @return TRUE on success
+ */
+UBYTE flash_program(void) OLDCALL BANKED;
+
+/**
+ * Apply every committed record over the SRAM banks restored from their
+ * mirrors and find the end of the log. Run after restore_sram_bank().
+ */
+void flash_journal_replay(void) BANKED;
+
+/**
+ * Persist a span of SRAM. Small spans are appended to the journal; when
+ * it fills up the whole save sector is erased and rewritten, which also
+ * empties the journal.
+ *
+ * @param bank SRAM bank of the span
+ * @param data Start of the span, between 0xA000 and 0xBFFF
+ * @param size Span length in bytes
+ * @return TRUE on success
+ */
+UBYTE flash_journal_write(UBYTE bank, const UBYTE *data, UWORD size) BANKED;
+
+// Erase the save sector, rewrite all SRAM mirrors and start an empty journal
+UBYTE flash_journal_compact(void) BANKED;
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef HDMA_H
+#define HDMA_H
+
+#include <gbdk/platform.h>
+
+// HDMA moves 16 byte blocks from 16 byte aligned sources to 16 byte aligned VRAM
+#define HDMA_BLOCK 16
+// Two staging buffers: one is filled from ROM while the other is transferred
+#define HDMA_STAGE_SIZE 256
+// Background map rows go out whole, so their VRAM address is aligned too
+#define HDMA_ROW_SIZE 32
+
+#define HDMA_GENERAL 0x00
+#define HDMA_HBLANK 0x80
+// HDMA5 bit 7 reads back 1 once a transfer ended (or was never started, and always on DMG)
+#define HDMA_IDLE 0x80
+
+#define HDMA_BKG_MAP ((UBYTE *)0x9800)
+
+inline UBYTE hdma_busy(void) {
+    return !(HDMA5_REG & HDMA_IDLE);
+}
+
+// Spin until the running transfer ends. VBK_REG must not change before this
+void hdma_wait(void) BANKED;
+
+/**
+ * Copy to VRAM through the staging buffers. General purpose DMA while the
+ * LCD is off, H-Blank DMA (one block per line) while it is on. CGB only.
+ * Only the ROM reads overlap the transfer: this returns once the last block
+ * has landed, so the call takes as many lines as there are blocks.
+ *
+ * @param vram Destination in the current VRAM bank, 16 byte aligned
+ * @param src Source data
+ * @param len Length, a multiple of 16
+ * @param bank Bank of the source
+ */
+void hdma_copy(UBYTE *vram, const UBYTE *src, UWORD len, UBYTE bank) BANKED;
+
+/**
+ * set_bkg_data() replacement for banked tile data, using hdma_copy() on CGB
+ * and SetBankedBkgData() on DMG. Assumes 0x8800 tile addressing.
+ *
+ * @param first First tile
+ * @param n Number of tiles, first + n must not exceed 256
+ * @param data Tile data
+ * @param bank Bank of the tile data
+ */
+void hdma_set_bkg_data(UBYTE first, UBYTE n, const UBYTE *data, UBYTE bank) BANKED;
+
+/**
+ * Staging buffer for the next whole map row; rows alternate between two so
+ * one can be built while the previous goes out.
+ *
+ * @return HDMA_ROW_SIZE byte buffer, 16 byte aligned
+ */
+UBYTE *hdma_row_begin(void) BANKED;
+
+/**
+ * Start the transfer of the buffer from hdma_row_begin() to a background
+ * map row in the current VRAM bank. CGB only.
+ *
+ * @param y Map row, 0 to 31
+ */
+void hdma_row_commit(UBYTE y) BANKED;
+
+#endif
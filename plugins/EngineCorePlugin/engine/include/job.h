@@ -0,0 +1,89 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "data/states_defines.h"
+
+// Scanlines of each frame that may be spent stepping jobs
+#ifndef JOB_SCANLINE_BUDGET
+#define JOB_SCANLINE_BUDGET 40
+#endif
+
+#define MAX_JOBS 4
+#define JOB_NONE 0xFF
+#define JOB_ALL  0xFE
+
+// Step handler results
+#define JOB_CONTINUE FALSE
+#define JOB_DONE     TRUE
+#define JOB_YIELD    2
+
+/**
+ * Job step handler. Called once per step with a step counter that starts at
+ * 0 and advances by one after every call that does not finish the job.
+ * Return JOB_CONTINUE (FALSE) to be stepped again while the frame budget
+ * lasts, JOB_YIELD when there is nothing more to do until the next frame,
+ * or JOB_DONE (TRUE) when the job has finished.
+ */
+typedef UBYTE (*JOB_STEP_FN)(UBYTE step) OLDCALL BANKED;
+
+typedef struct job_t {
+    void * fn;
+    UBYTE fn_bank;
+    UBYTE step;
+    // Optional JOB_STEP_FN called if the job is dropped before it finishes
+    void * cancel;
+    UBYTE cancel_bank;
+} job_t;
+
+extern job_t jobs[MAX_JOBS];
+extern UBYTE jobs_active;
+
+/**
+ * Drop all pending jobs, calling the cancel hook of each one that has
+ * one. Called on reset, load and scene change, since jobs usually work on
+ * the tilemap of the current scene.
+ */
+void jobs_init(void) BANKED;
+
+/**
+ * Queue a job, or restart it from step 0 if the same handler is already
+ * queued.
+ *
+ * @param bank Bank of the step handler
+ * @param fn Step handler
+ * @return Job ID, or JOB_NONE if all slots are taken
+ */
+UBYTE job_start(UBYTE bank, void * fn) BANKED;
+
+/**
+ * Set the handler jobs_init() calls, with the step the job had reached,
+ * if it drops the job before it finishes. Use it to undo state the job
+ * set up in earlier steps. The return value is ignored.
+ *
+ * @param id Job ID returned by job_start()
+ * @param bank Bank of the cancel handler
+ * @param fn Cancel handler, a JOB_STEP_FN
+ */
+void job_set_cancel(UBYTE id, UBYTE bank, void * fn) BANKED;
+
+/**
+ * Check whether a job is still running.
+ *
+ * @param id Job ID returned by job_start(), or JOB_ALL for any job
+ * @return TRUE while the job has steps left
+ */
+UBYTE job_is_running(UBYTE id) BANKED;
+
+/**
+ * Step queued jobs until the frame budget is spent or every job has
+ * yielded. Every job gets at least one step per frame so that large steps
+ * still make progress.
+ */
+void jobs_update(void) BANKED;
+
+// Script access: wait until the job ID on the stack (or JOB_ALL) has finished
+void vm_job_wait(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef NATIVE_BATCH_H
+#define NATIVE_BATCH_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+
+// Most arguments one batched call can take (one bit each in the variable mask)
+#define NATIVE_BATCH_MAX_ARGS 8
+
+// Native routine signature, called the same way VM_CALL_NATIVE calls it
+typedef void (*SCRIPT_NATIVE_FN)(SCRIPT_CTX * THIS) OLDCALL BANKED;
+
+/*
+ * Descriptor list that follows `VM_CALL_NATIVE b_vm_call_native_batch, _vm_call_native_batch`
+ * in the bytecode. All words are little endian.
+ *
+ *   .db count
+ *   per call:
+ *     .db #<b_fn, #<_fn, #>_fn     native routine
+ *     .db nargs, varmask           argument count, bit n set if arg n is a variable reference
+ *     .db #<arg0, #>arg0, ...      immediates or variable references, ARG0 first
+ */
+typedef struct native_batch_call_t {
+    UBYTE bank;
+    UWORD fn;
+    UBYTE nargs;
+    UBYTE varmask;
+} native_batch_call_t;
+
+/**
+ * Run every call in the descriptor list that follows the instruction, then
+ * continue after the list. Each call sees its arguments on the VM stack as
+ * FN_ARG0..FN_ARGn, exactly as if the event had pushed them, and they are
+ * popped afterwards. Variable arguments are pushed by value, so a write
+ * through *(T*)VM_REF_TO_PTR(FN_ARGn) only changes the stack copy and is
+ * lost. Natives that return results that way, wait or move the PC can't
+ * be batched.
+ */
+void vm_call_native_batch(SCRIPT_CTX * THIS) OLDCALL BANKED;
+
+#endif
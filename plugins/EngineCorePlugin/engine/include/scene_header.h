@@ -0,0 +1,30 @@
+#ifndef SCENE_HEADER_H
+#define SCENE_HEADER_H
+
+#include <gbdk/platform.h>
+#include "gbs_types.h"
+
+// Scenes whose background header is kept resolved; a power of two
+#define SCENE_HEADER_CACHE_SIZE 4
+
+// What copy natives need from a scene, read once from its scene_t and background_t
+typedef struct scene_header_t {
+    UBYTE scene_bank;
+    const scene_t *scene_ptr;
+    far_ptr_t collisions;
+    background_t background;
+} scene_header_t;
+
+extern scene_header_t scene_header_cache[SCENE_HEADER_CACHE_SIZE];
+
+/**
+ * Resolve a scene's background and collision far pointers. Scene data is
+ * in ROM, so entries never go stale; the oldest one is replaced on a miss.
+ *
+ * @param bank Bank of the scene
+ * @param scene Scene pointer
+ * @return Cache entry, valid until the next call
+ */
+const scene_header_t *scene_header_get(UBYTE bank, const scene_t *scene) BANKED;
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SCENE_STREAM_H
+#define SCENE_STREAM_H
+
+#include <gbdk/platform.h>
+#include "gbs_types.h"
+#include "actor.h"
+#include "projectiles.h"
+#include "data_manager.h"
+#include "vm.h"
+
+// Scene sprites and exclusive actor sprites whose tiles are not uploaded yet
+#define SCENE_STREAM_SPRITE_BYTES ((MAX_SCENE_SPRITES + 7) >> 3)
+#define SCENE_STREAM_ACTOR_BYTES ((MAX_ACTORS + 7) >> 3)
+#define SCENE_STREAM_NONE 0xFF
+
+// TRUE once every tile upload queued by load_scene() has been done
+extern UBYTE scene_ready;
+// Uploads still pending; zero when the stream is idle
+extern UBYTE scene_stream_left;
+extern UBYTE scene_stream_sprite_pending[SCENE_STREAM_SPRITE_BYTES];
+extern UBYTE scene_stream_actor_pending[SCENE_STREAM_ACTOR_BYTES];
+// Scene sprite each actor and projectile draws from, SCENE_STREAM_NONE if none or exclusive
+extern UBYTE scene_stream_actor_sprite[MAX_ACTORS];
+extern UBYTE scene_stream_projectile_sprite[MAX_PROJECTILE_DEFS];
+
+/**
+ * Forget pending uploads and remember where the scene's sprite list is.
+ *
+ * @param bank Bank of the scene sprite far pointer list
+ * @param sprites Scene sprite far pointer list
+ */
+void scene_stream_reset(UBYTE bank, const far_ptr_t *sprites) BANKED;
+
+/**
+ * Number of sprite tiles a spritesheet takes, without uploading them.
+ *
+ * @param sprite Spritesheet
+ * @param bank Bank of the spritesheet
+ * @return Tile count, the larger of the DMG and CGB tilesets on CGB
+ */
+UBYTE scene_stream_sprite_tiles(const spritesheet_t *sprite, UBYTE bank) BANKED;
+
+// Queue a scene sprite for upload
+void scene_stream_queue_sprite(UBYTE idx) BANKED;
+
+// Queue an actor's exclusive sprite (uploaded at its base tile) for upload
+void scene_stream_queue_actor(actor_t *actor) BANKED;
+
+// Start the job that uploads queued sprites under the job budget; sets scene_ready when done
+void scene_stream_start(void) BANKED;
+
+// Upload a scene sprite now if it is still pending
+void scene_stream_sprite(UBYTE idx) BANKED;
+
+// Upload the tiles an actor draws from now if they are still pending
+void scene_stream_actor(actor_t *actor) BANKED;
+
+// Upload everything still pending
+void scene_stream_flush(void) BANKED;
+
+// Job step: upload one pending sprite
+UBYTE scene_stream_step(UBYTE step) OLDCALL BANKED;
+
+// Script access: wait until the current scene has finished streaming
+void vm_scene_wait_ready(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
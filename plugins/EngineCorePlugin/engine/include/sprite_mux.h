@@ -0,0 +1,76 @@
+#ifndef SPRITE_MUX_H
+#define SPRITE_MUX_H
+
+#include <gbdk/platform.h>
+#include <gbdk/metasprites.h>
+#include "gbs_types.h"
+#include "actor.h"
+#include "vm.h"
+#include "data/states_defines.h"
+
+// Hardware sprites actors (and the emote) may take each frame; the rest is left to projectiles
+#ifndef SPRITE_MUX_BUDGET
+#define SPRITE_MUX_BUDGET 32
+#endif
+
+// Sprites the PPU shows on one scanline
+#define SPRITE_MUX_LINE_LIMIT 10
+// Visible actors are bucketed by screen y in 16px bands. An actor is about
+// one band tall, so a line in band b is crossed by actors in bands b and b + 1.
+#define SPRITE_MUX_BAND_SHIFT 4
+#define SPRITE_MUX_BANDS 16
+
+typedef struct sprite_mux_entry_t {
+    actor_t *actor;
+    UBYTE bank;
+    const metasprite_t *metasprite;
+    UBYTE x, y;
+    // Hardware sprites in the metasprite
+    UBYTE count;
+} sprite_mux_entry_t;
+
+// Actors to draw this frame in list order, filled by actors_update()
+extern sprite_mux_entry_t sprite_mux_entries[MAX_ACTORS];
+extern UBYTE sprite_mux_len;
+// Entry indices in draw order, sorted by band on overloaded frames and in
+// list order otherwise; drawing starts at sprite_mux_start and wraps
+extern UBYTE sprite_mux_order[MAX_ACTORS];
+extern UBYTE sprite_mux_start;
+
+// Actors left out by the budget last frame
+extern UBYTE sprite_mux_dropped;
+// Estimated sprites on the busiest scanline last frame
+extern UBYTE sprite_mux_peak;
+// Frames that needed rotating since boot
+extern UWORD sprite_mux_overloads;
+
+/**
+ * Count the hardware sprites in a metasprite. The metasprite's bank must be
+ * switched in.
+ *
+ * @param metasprite Metasprite to count
+ * @return Number of entries before metasprite_end
+ */
+inline UBYTE sprite_mux_count(const metasprite_t *metasprite) {
+    UBYTE count = 0;
+    while (metasprite->dy != metasprite_end) count++, metasprite++;
+    return count;
+}
+
+// Clear the stats and the rotation
+void sprite_mux_init(void) BANKED;
+
+/**
+ * Estimate the busiest scanline and pick the draw order. Frames that fit
+ * keep list order. When the budget or a scanline would overflow, the
+ * entries are bucket sorted by band and the start rotates by one entry
+ * each frame, so a different actor loses out every frame.
+ *
+ * @param reserved Hardware sprites already allocated this frame
+ */
+void sprite_mux_sort(UBYTE reserved) BANKED;
+
+// Script access: store dropped actors, peak line load and overloaded frames in three variables
+void vm_sprite_mux_get_stats(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef UI_TEXT_CACHE_H
+#define UI_TEXT_CACHE_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "data/states_defines.h"
+
+// Rendered VWF tiles kept in WRAM, 16 bytes each; 0 turns the cache off
+#ifndef UI_TEXT_CACHE_TILES
+#define UI_TEXT_CACHE_TILES 24
+#endif
+#define UI_TEXT_CACHE_ENTRIES 8
+// Shorter runs are cheaper to render than to look up
+#define UI_TEXT_CACHE_MIN_RUN 2
+
+// Control codes 0x00-0x0D are handled by ui_draw_text_buffer_char(), except 0x0C which prints
+#define UI_TEXT_CACHE_IS_CHAR(c) (((c) > 0x0Du) || ((c) == 0x0Cu))
+
+// One run of printable characters, rendered from a tile boundary. Its complete
+// tiles are stored from pool tile `first` on, followed by the trailing partial tile if any.
+// The characters are kept alongside, so a hash match is confirmed before it counts
+typedef struct ui_text_cache_entry_t {
+    UWORD hash;
+    UBYTE len;      // characters in the run, 0 = free slot
+    UBYTE key;      // background fill and direction
+    UBYTE first;
+    UBYTE tiles;    // complete tiles
+    UBYTE offset;   // pixels used in the trailing partial tile
+} ui_text_cache_entry_t;
+
+extern UBYTE ui_text_cache_pool[UI_TEXT_CACHE_TILES * 16];
+// Characters of the run being recorded still to render
+extern UBYTE ui_text_cache_rec_left;
+// Length of the run measured by the last ui_text_cache_find()
+extern UBYTE ui_text_cache_run_len;
+// Set while pre-rendering, so nothing is written to VRAM
+extern UBYTE ui_text_cache_dry;
+
+// Drop every entry; called by ui_init() and when the pool fills up
+void ui_text_cache_reset(void) BANKED;
+
+/**
+ * Measure the run of printable characters at text and look it up, keyed
+ * by the current font, background fill and direction.
+ *
+ * @param text Start of the run in ui_text_data
+ * @return Matching entry, or NULL
+ */
+const ui_text_cache_entry_t *ui_text_cache_find(const unsigned char *text) BANKED;
+
+// Start recording the run measured by the last miss; leaves ui_text_cache_rec_left 0 if it won't fit
+void ui_text_cache_record_begin(void) BANKED;
+// Store a tile completed while recording
+void ui_text_cache_record_tile(const UBYTE *tile) BANKED;
+// Store the partial tile and publish the entry once the run is rendered
+void ui_text_cache_record_end(UBYTE offset, const UBYTE *tile) BANKED;
+
+/**
+ * Render every run in ui_text_data into the cache without drawing it, so
+ * the first time the text is shown is already a tile copy. Must not be
+ * called while text is being drawn.
+ */
+void ui_text_cache_prerender(void) BANKED;
+
+void vm_ui_text_cache_prerender(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef VM_PROFILER_H
+#define VM_PROFILER_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "data/states_defines.h"
+
+#ifndef VM_PROFILER
+#define VM_PROFILER 0
+#endif
+#ifndef VM_PROFILER_SRAM_BANK
+#define VM_PROFILER_SRAM_BANK 3
+#endif
+
+// Frames accumulated into one ring record before moving to the next
+#define VM_PROFILE_PERIOD 64
+// Records kept in the SRAM ring
+#define VM_PROFILE_RECORDS 8
+// opcodes run up to 0x8E; anything past the table lands in the last slot
+#define VM_PROFILE_OPCODES 0x90
+// Script regions are 16 byte spans of bytecode, hashed by bank:PC
+#define VM_PROFILE_REGION_SHIFT 4
+#define VM_PROFILE_REGIONS 64
+#define VM_PROFILE_NATIVES 16
+#define VM_PROFILE_PROBES 4
+
+#define VM_PROFILE_OP_CALL_NATIVE 0x2D
+
+#define VM_PROFILE_MAGIC "VMP1"
+
+// A counted location: a bytecode region or a native call target (bank 0 = empty slot)
+typedef struct vm_profile_site_t {
+    UBYTE bank;
+    UWORD addr;
+    UWORD count;
+} vm_profile_site_t;
+
+typedef struct vm_profile_record_t {
+    UWORD frames;
+    UWORD steps;
+    // sites that found no free slot
+    UWORD dropped;
+    UWORD opcodes[VM_PROFILE_OPCODES];
+    UWORD contexts[VM_MAX_CONTEXTS];
+    vm_profile_site_t regions[VM_PROFILE_REGIONS];
+    vm_profile_site_t natives[VM_PROFILE_NATIVES];
+} vm_profile_record_t;
+
+// Lives at the start of SRAM bank VM_PROFILER_SRAM_BANK; counters saturate at 0xFFFF
+typedef struct vm_profile_sram_t {
+    char magic[4];
+    UWORD record_size;
+    UBYTE record_count;
+    UBYTE head;
+    UWORD sequence;
+    vm_profile_record_t records[VM_PROFILE_RECORDS];
+} vm_profile_sram_t;
+
+#define VM_PROFILE_SRAM ((vm_profile_sram_t *)0xA000u)
+
+#if VM_PROFILER
+
+/**
+ * Count the instruction a context is about to execute. Reads the opcode
+ * (and the target of vm_call_native) from the bytecode bank, then switches
+ * to the profiler SRAM bank and back to bank 0 for the map data.
+ *
+ * @param ctx Context about to step
+ */
+void vm_profile_step(SCRIPT_CTX * ctx) BANKED;
+
+// Close the frame; every VM_PROFILE_PERIOD frames the ring moves to a cleared record
+void vm_profile_frame_end(void) BANKED;
+
+#define VM_PROFILE_STEP(ctx) vm_profile_step(ctx)
+
+#else
+
+#define VM_PROFILE_STEP(ctx)
+
+#endif
+
+// Clear the ring and write the header
+void vm_profile_init(void) BANKED;
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef VM_SLEEP_H
+#define VM_SLEEP_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+
+// Contexts in a timed wait are moved off the run list onto a wake list kept
+// sorted by wake frame. Each entry stores the frames after its predecessor,
+// so the runner only counts down the head. Entries are indexed by context ID - 1.
+#define VM_SLEEP_END 0xFF
+// vm_sleep_next value of a context that is not on the wake list
+#define VM_SLEEP_AWAKE 0xFE
+
+// last context of the run list, so spawning appends without a walk
+extern SCRIPT_CTX * last_ctx;
+
+extern UBYTE vm_sleep_head;
+extern UBYTE vm_sleep_next[VM_MAX_CONTEXTS];
+extern UBYTE vm_sleep_prev[VM_MAX_CONTEXTS];
+extern UWORD vm_sleep_delta[VM_MAX_CONTEXTS];
+// frames requested by wait_frames() for the context being stepped, 0 if none
+extern UWORD vm_sleep_frames;
+
+// Context for a thread ID, the ID is fixed per context slot
+#define VM_CTX_BY_ID(ID) (CTXS + ((ID) - 1))
+
+// Move the contexts whose wait has run out back onto the run list; call once per runner update
+void script_wake_update(void) BANKED;
+
+// Put a context that has been unlinked from the run list onto the wake list
+void script_sleep(SCRIPT_CTX * ctx, UWORD frames) BANKED;
+
+#endif
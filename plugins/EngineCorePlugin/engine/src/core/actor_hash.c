@@ -0,0 +1,124 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "actor_hash.h"
+#include "actor.h"
+#include "data_manager.h"
+
+// Singly linked bucket lists of actor indices
+UBYTE actor_hash_head[ACTOR_HASH_BUCKETS + 1];
+UBYTE actor_hash_next[MAX_ACTORS];
+// Bucket each actor is linked into, ACTOR_HASH_NONE if not hashed
+UBYTE actor_hash_bucket[MAX_ACTORS];
+UBYTE actor_hash_candidates[MAX_ACTORS];
+UBYTE actor_hash_groups;
+
+void actor_hash_init(void) BANKED {
+    memset(actor_hash_head, ACTOR_HASH_NONE, sizeof(actor_hash_head));
+    memset(actor_hash_bucket, ACTOR_HASH_NONE, sizeof(actor_hash_bucket));
+    actor_hash_groups = 0;
+}
+
+static void actor_hash_unlink(UBYTE idx) {
+    UBYTE bucket = actor_hash_bucket[idx];
+    if (bucket == ACTOR_HASH_NONE) return;
+    actor_hash_bucket[idx] = ACTOR_HASH_NONE;
+
+    UBYTE *link = &actor_hash_head[bucket];
+    while (*link != ACTOR_HASH_NONE) {
+        if (*link == idx) {
+            *link = actor_hash_next[idx];
+            return;
+        }
+        link = &actor_hash_next[*link];
+    }
+}
+
+static void actor_hash_link(UBYTE idx, UBYTE bucket) {
+    actor_hash_next[idx] = actor_hash_head[bucket];
+    actor_hash_head[bucket] = idx;
+    actor_hash_bucket[idx] = bucket;
+}
+
+void actor_hash_insert(actor_t *actor) BANKED {
+    UBYTE idx = actor - actors;
+    actor_hash_unlink(idx);
+    actor_hash_link(idx, actor_hash_bucket_of(actor));
+    // groups are only ever added here; the next refresh drops stale ones
+    actor_hash_groups |= actor->collision_group;
+}
+
+void actor_hash_remove(actor_t *actor) BANKED {
+    actor_hash_unlink(actor - actors);
+}
+
+void actor_hash_update(void) BANKED {
+    // walk the array rather than the active list so the index comes for free
+    actor_t *actor = actors;
+    UBYTE groups = 0;
+    for (UBYTE idx = 0; idx != MAX_ACTORS; idx++, actor++) {
+        if (!actor->active || (idx >= actors_len)) {
+            // load_scene() drops actors without deactivating them, so unlink leftovers here
+            if (actor_hash_bucket[idx] != ACTOR_HASH_NONE) actor_hash_unlink(idx);
+            continue;
+        }
+        if (actor->collision_enabled) groups |= actor->collision_group;
+        UBYTE bucket = actor_hash_bucket_of(actor);
+        if (bucket == actor_hash_bucket[idx]) continue;
+        actor_hash_unlink(idx);
+        actor_hash_link(idx, bucket);
+    }
+    actor_hash_groups = groups;
+}
+
+static UBYTE actor_hash_collect(UBYTE bucket, UBYTE count) {
+    for (UBYTE idx = actor_hash_head[bucket]; idx != ACTOR_HASH_NONE; idx = actor_hash_next[idx]) {
+        actor_hash_candidates[count++] = idx;
+    }
+    return count;
+}
+
+UBYTE actor_hash_query(WORD x0, WORD y0, WORD x1, WORD y1) BANKED {
+    // cells wrap as UBYTE, so positions just left of or above the scene hash consistently
+    UBYTE cx0 = (UBYTE)(x0 >> ACTOR_HASH_CELL_PX_SHIFT), cx1 = (UBYTE)(x1 >> ACTOR_HASH_CELL_PX_SHIFT);
+    UBYTE cy0 = (UBYTE)(y0 >> ACTOR_HASH_CELL_PX_SHIFT), cy1 = (UBYTE)(y1 >> ACTOR_HASH_CELL_PX_SHIFT);
+    UBYTE w = (UBYTE)(cx1 - cx0 + 1), h = (UBYTE)(cy1 - cy0 + 1);
+    // also keeps w and h within one alias period, so no bucket is visited twice
+    if ((w == 0) || (h == 0) || ((UWORD)w * h > ACTOR_HASH_MAX_QUERY_CELLS)) return ACTOR_HASH_SCAN_ALL;
+
+    UBYTE count = actor_hash_collect(ACTOR_HASH_OVERSIZE, 0);
+    UBYTE cy = cy0;
+    for (UBYTE j = h; j != 0; j--, cy++) {
+        UBYTE cx = cx0;
+        for (UBYTE i = w; i != 0; i--, cx++) {
+            count = actor_hash_collect(ACTOR_HASH_BUCKET_OF(cx, cy), count);
+        }
+    }
+    return count;
+}
+
+actor_t *actor_hash_overlapping_group(bounding_box_t *bb, point16_t *offset, UBYTE mask) BANKED {
+    if ((actor_hash_groups & mask) == 0) return NULL;
+
+    WORD px = offset->x >> 4, py = offset->y >> 4;
+    UBYTE count = actor_hash_query(px + bb->left - (ACTOR_HASH_REACH + ACTOR_HASH_SLACK),
+                                   py + bb->top - (ACTOR_HASH_REACH + ACTOR_HASH_SLACK),
+                                   px + bb->right + (ACTOR_HASH_REACH + ACTOR_HASH_SLACK),
+                                   py + bb->bottom + (ACTOR_HASH_REACH + ACTOR_HASH_SLACK));
+    if (count != ACTOR_HASH_SCAN_ALL) {
+        for (UBYTE i = 0; i != count; i++) {
+            actor_t *actor = actors + actor_hash_candidates[i];
+            if (!actor->active || !actor->collision_enabled || !(actor->collision_group & mask)) continue;
+            if (bb_intersects(bb, offset, &actor->bounds, &actor->pos)) return actor;
+        }
+        return NULL;
+    }
+
+    for (actor_t *actor = &PLAYER; actor; actor = actor->prev) {
+        if (!actor->collision_enabled || !(actor->collision_group & mask)) continue;
+        if (bb_intersects(bb, offset, &actor->bounds, &actor->pos)) return actor;
+    }
+    return NULL;
+}
@@ -0,0 +1,82 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "actor_lines.h"
+#include "actor.h"
+#include "data_manager.h"
+
+UBYTE actor_lines_row_head[ACTOR_LINES_BUCKETS];
+UBYTE actor_lines_row_next[MAX_ACTORS];
+UBYTE actor_lines_col_head[ACTOR_LINES_BUCKETS + 1];
+UBYTE actor_lines_col_next[MAX_ACTORS];
+UBYTE actor_lines_stale;
+
+// Bucket each actor is linked into, ACTOR_LINES_NONE if not linked
+static UBYTE actor_lines_row[MAX_ACTORS];
+static UBYTE actor_lines_col[MAX_ACTORS];
+
+void actor_lines_init(void) BANKED {
+    memset(actor_lines_row_head, ACTOR_LINES_NONE, sizeof(actor_lines_row_head));
+    memset(actor_lines_col_head, ACTOR_LINES_NONE, sizeof(actor_lines_col_head));
+    memset(actor_lines_row, ACTOR_LINES_NONE, sizeof(actor_lines_row));
+    memset(actor_lines_col, ACTOR_LINES_NONE, sizeof(actor_lines_col));
+    actor_lines_stale = TRUE;
+}
+
+static void actor_lines_unlink(UBYTE *head, UBYTE *next, UBYTE idx) {
+    UBYTE *link = head;
+    while (*link != ACTOR_LINES_NONE) {
+        if (*link == idx) {
+            *link = next[idx];
+            return;
+        }
+        link = &next[*link];
+    }
+}
+
+void actor_lines_remove(actor_t *actor) BANKED {
+    UBYTE idx = actor - actors;
+    if (actor_lines_row[idx] != ACTOR_LINES_NONE) {
+        actor_lines_unlink(&actor_lines_row_head[actor_lines_row[idx]], actor_lines_row_next, idx);
+        actor_lines_row[idx] = ACTOR_LINES_NONE;
+    }
+    if (actor_lines_col[idx] != ACTOR_LINES_NONE) {
+        actor_lines_unlink(&actor_lines_col_head[actor_lines_col[idx]], actor_lines_col_next, idx);
+        actor_lines_col[idx] = ACTOR_LINES_NONE;
+    }
+}
+
+void actor_lines_refresh(void) BANKED {
+    actor_t *actor = actors;
+    for (UBYTE idx = 0; idx != MAX_ACTORS; idx++, actor++) {
+        UBYTE row = ACTOR_LINES_NONE, col = ACTOR_LINES_NONE;
+        // slots past actors_len hold leftovers from the previous scene
+        if ((idx < actors_len) && !actor->active && !actor->disabled) {
+            row = (UBYTE)(actor->pos.y >> 7) & (ACTOR_LINES_BUCKETS - 1);
+            col = (actor->bounds.right > ACTOR_LINES_REACH) ? ACTOR_LINES_WIDE : (UBYTE)(actor->pos.x >> 7) & (ACTOR_LINES_BUCKETS - 1);
+        }
+        if (row != actor_lines_row[idx]) {
+            if (actor_lines_row[idx] != ACTOR_LINES_NONE) {
+                actor_lines_unlink(&actor_lines_row_head[actor_lines_row[idx]], actor_lines_row_next, idx);
+            }
+            if (row != ACTOR_LINES_NONE) {
+                actor_lines_row_next[idx] = actor_lines_row_head[row];
+                actor_lines_row_head[row] = idx;
+            }
+            actor_lines_row[idx] = row;
+        }
+        if (col != actor_lines_col[idx]) {
+            if (actor_lines_col[idx] != ACTOR_LINES_NONE) {
+                actor_lines_unlink(&actor_lines_col_head[actor_lines_col[idx]], actor_lines_col_next, idx);
+            }
+            if (col != ACTOR_LINES_NONE) {
+                actor_lines_col_next[idx] = actor_lines_col_head[col];
+                actor_lines_col_head[col] = idx;
+            }
+            actor_lines_col[idx] = col;
+        }
+    }
+    actor_lines_stale = FALSE;
+}
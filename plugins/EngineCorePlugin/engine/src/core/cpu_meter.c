@@ -0,0 +1,107 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "cpu_meter.h"
+#include "system.h"
+#include "ui.h"
+#include "vm.h"
+
+#if CPU_METER
+
+UBYTE cpu_meter_start_line[CPU_METER_STAGE_COUNT];
+UBYTE cpu_meter_start_frame[CPU_METER_STAGE_COUNT];
+UWORD cpu_meter_accum[CPU_METER_STAGE_COUNT];
+UWORD cpu_meter_history[CPU_METER_HISTORY][CPU_METER_STAGE_COUNT];
+UBYTE cpu_meter_head;
+UBYTE cpu_meter_bar_enabled;
+
+// Bar length currently on screen, so the window is only touched when it changes
+static UBYTE cpu_meter_bar_length;
+static UBYTE cpu_meter_bar_tiles[CPU_METER_BAR_WIDTH];
+
+static void cpu_meter_draw_bar(UWORD total_lines) {
+    // One tile per 8 scanlines: a full 154 line frame fills 19-20 tiles
+    UBYTE length = (total_lines >= (CPU_METER_BAR_WIDTH << 3)) ? CPU_METER_BAR_WIDTH : (UBYTE)(total_lines >> 3);
+    if (length == cpu_meter_bar_length) return;
+    cpu_meter_bar_length = length;
+
+    for (UBYTE i = 0; i < CPU_METER_BAR_WIDTH; i++) {
+        cpu_meter_bar_tiles[i] = (i < length) ? ui_black_tile : ui_white_tile;
+    }
+    set_win_tiles(0, CPU_METER_BAR_ROW, CPU_METER_BAR_WIDTH, 1, cpu_meter_bar_tiles);
+
+#ifdef CGB
+    if (_is_CGB) {
+        UBYTE pal = (total_lines < ((CPU_METER_LINES_PER_FRAME * 3) >> 2)) ? CPU_METER_PAL_LOW :
+                    (total_lines < CPU_METER_LINES_PER_FRAME) ? CPU_METER_PAL_HIGH : CPU_METER_PAL_OVER;
+        memset(cpu_meter_bar_tiles, pal, CPU_METER_BAR_WIDTH);
+        VBK_REG = 1;
+        set_win_tiles(0, CPU_METER_BAR_ROW, CPU_METER_BAR_WIDTH, 1, cpu_meter_bar_tiles);
+        VBK_REG = 0;
+    }
+#endif
+}
+
+void cpu_meter_init(void) BANKED {
+    memset(cpu_meter_accum, 0, sizeof(cpu_meter_accum));
+    memset(cpu_meter_history, 0, sizeof(cpu_meter_history));
+    cpu_meter_head = 0;
+    cpu_meter_bar_enabled = FALSE;
+    cpu_meter_bar_length = 0xFF;
+}
+
+void cpu_meter_frame_end(void) BANKED {
+    UWORD * slot = cpu_meter_history[cpu_meter_head];
+    memcpy(slot, cpu_meter_accum, sizeof(cpu_meter_accum));
+    memset(cpu_meter_accum, 0, sizeof(cpu_meter_accum));
+    cpu_meter_head = (cpu_meter_head + 1) & (CPU_METER_HISTORY - 1);
+
+    if (cpu_meter_bar_enabled) cpu_meter_draw_bar(slot[CPU_METER_STAGE_TOTAL]);
+}
+
+#else
+
+void cpu_meter_init(void) BANKED {
+}
+
+void cpu_meter_frame_end(void) BANKED {
+}
+
+#endif
+
+void vm_cpu_meter_get_costs(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    UBYTE stage = *(UBYTE *)VM_REF_TO_PTR(FN_ARG0);
+    UBYTE count = *(UBYTE *)VM_REF_TO_PTR(FN_ARG1);
+    INT16 dest = *(INT16 *)VM_REF_TO_PTR(FN_ARG2);
+
+    if (count > CPU_METER_HISTORY) count = CPU_METER_HISTORY;
+
+#if CPU_METER
+    if (stage >= CPU_METER_STAGE_COUNT) stage = CPU_METER_STAGE_TOTAL;
+    // newest frame first
+    UBYTE idx = cpu_meter_head;
+    for (UBYTE i = 0; i < count; i++) {
+        idx = (idx - 1) & (CPU_METER_HISTORY - 1);
+        script_memory[dest + i] = cpu_meter_history[idx][stage];
+    }
+#else
+    stage;
+    for (UBYTE i = 0; i < count; i++) {
+        script_memory[dest + i] = 0;
+    }
+#endif
+}
+
+void vm_cpu_meter_show_bar(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+#if CPU_METER
+    cpu_meter_bar_enabled = *(UBYTE *)VM_REF_TO_PTR(FN_ARG0);
+    // force a redraw the next time the bar is enabled
+    cpu_meter_bar_length = 0xFF;
+#else
+    THIS;
+#endif
+}
@@ -0,0 +1,58 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+
+#include "cpu_turbo.h"
+#include "system.h"
+#include "vm.h"
+
+UBYTE cpu_turbo_depth;
+UBYTE cpu_turbo_held;
+
+#if defined(CGB) && (CGB_CPU_SPEED == CGB_CPU_SPEED_SECTIONS)
+static void cpu_turbo_update(void) {
+    if (!_is_CGB) return;
+    UBYTE fast = (cpu_turbo_depth || cpu_turbo_held);
+    if (fast == ((KEY1_REG & 0x80) != 0)) return;
+    CRITICAL {
+        // the switch clears IF around STOP; raise again whatever was pending so
+        // no VBlank (game_time) or timer (music) tick is lost
+        UBYTE pending = IF_REG;
+        if (fast) cpu_fast(); else cpu_slow();
+        IF_REG |= pending;
+        TMA_REG = CPU_TURBO_TMA;
+    }
+}
+#else
+#define cpu_turbo_update()
+#endif
+
+void cpu_turbo_init(void) BANKED {
+    cpu_turbo_depth = cpu_turbo_held = 0;
+#if defined(CGB) && (CGB_CPU_SPEED == CGB_CPU_SPEED_ALWAYS)
+    if (_is_CGB) cpu_fast();
+#endif
+}
+
+void cpu_turbo_reset(void) BANKED {
+    cpu_turbo_depth = cpu_turbo_held = 0;
+}
+
+void cpu_turbo_begin(void) BANKED {
+    cpu_turbo_depth++;
+    cpu_turbo_update();
+}
+
+void cpu_turbo_end(void) BANKED {
+    if (cpu_turbo_depth) cpu_turbo_depth--;
+    cpu_turbo_update();
+}
+
+void cpu_turbo_hold(UBYTE holder, UBYTE hold) BANKED {
+    if (hold) cpu_turbo_held |= holder; else cpu_turbo_held &= ~holder;
+    cpu_turbo_update();
+}
+
+void vm_cpu_turbo_hold(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    cpu_turbo_hold(CPU_TURBO_HOLD_SCRIPT, *(UBYTE *)VM_REF_TO_PTR(FN_ARG0));
+}
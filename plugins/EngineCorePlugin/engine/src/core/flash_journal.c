@@ -0,0 +1,128 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "flash_journal.h"
+#include "bankdata.h"
+#include "system.h"
+#include "flasher.h"
+#include "load_save.h"
+
+extern void _start_save;
+
+#define FLASH_JOURNAL_ROM_BANK(n) ((UBYTE)&_start_save + FLASH_JOURNAL_FIRST_BANK + (n))
+#define FLASH_JOURNAL_START ((UBYTE *)0x4000)
+#define FLASH_JOURNAL_LIMIT 0x8000u
+
+UBYTE flash_journal_bank;
+UBYTE *flash_journal_ptr;
+UBYTE flash_journal_broken;
+
+UBYTE flash_prog_bank;
+UBYTE *flash_prog_dest;
+const UBYTE *flash_prog_src;
+UBYTE flash_prog_len;
+
+// Header and payload are staged in WRAM; flash can't be programmed while SRAM is mapped
+static UBYTE flash_journal_buf[FLASH_JOURNAL_HEADER_SIZE + FLASH_JOURNAL_CHUNK];
+
+static UBYTE flash_journal_fits(UBYTE size) {
+    return ((UWORD)flash_journal_ptr + size) <= FLASH_JOURNAL_LIMIT;
+}
+
+// Walk one journal bank, applying committed records; returns the end of its log
+static UBYTE *flash_journal_scan(UBYTE n) {
+    UBYTE rom_bank = FLASH_JOURNAL_ROM_BANK(n);
+    UBYTE *ptr = FLASH_JOURNAL_START;
+    UBYTE *header = flash_journal_buf;
+    while (((UWORD)ptr + FLASH_JOURNAL_RECORD_SIZE(1)) <= FLASH_JOURNAL_LIMIT) {
+        MemcpyBanked(header, ptr, FLASH_JOURNAL_HEADER_SIZE, rom_bank);
+        if (header[0] == FLASH_JOURNAL_END) break;
+        UBYTE len = header[3];
+        UWORD offset = header[1] | ((UWORD)header[2] << 8);
+        // anything unexpected, including a record cut short by power loss, ends replay
+        if ((header[0] >= SRAM_BANKS_TO_SAVE) || (len == 0) || (len > FLASH_JOURNAL_CHUNK) ||
+            ((offset + len) > SRAM_BANK_SIZE) ||
+            (((UWORD)ptr + FLASH_JOURNAL_RECORD_SIZE(len)) > FLASH_JOURNAL_LIMIT) ||
+            (ReadBankedUBYTE(ptr + FLASH_JOURNAL_HEADER_SIZE + len, rom_bank) != FLASH_JOURNAL_COMMIT)) {
+            flash_journal_broken = TRUE;
+            break;
+        }
+        SWITCH_RAM_BANK(header[0], RAM_BANKS_ONLY);
+        MemcpyBanked((UBYTE *)0xA000u + offset, ptr + FLASH_JOURNAL_HEADER_SIZE, len, rom_bank);
+        ptr += FLASH_JOURNAL_RECORD_SIZE(len);
+    }
+    return ptr;
+}
+
+void flash_journal_replay(void) BANKED {
+    UBYTE _save = _current_ram_bank;
+    flash_journal_broken = FALSE;
+    flash_journal_bank = 0;
+    flash_journal_ptr = flash_journal_scan(0);
+    // records only move on to the next bank when one didn't fit in the previous
+    if (!flash_journal_broken && (ReadBankedUBYTE(FLASH_JOURNAL_START, FLASH_JOURNAL_ROM_BANK(1)) != FLASH_JOURNAL_END)) {
+        flash_journal_bank = 1;
+        flash_journal_ptr = flash_journal_scan(1);
+    }
+    SWITCH_RAM_BANK(_save, RAM_BANKS_AND_FLAGS);
+}
+
+UBYTE flash_journal_compact(void) BANKED {
+    flash_journal_bank = 0;
+    flash_journal_ptr = FLASH_JOURNAL_START;
+    flash_journal_broken = FALSE;
+    return save_sram(SRAM_BANKS_TO_SAVE);
+}
+
+// Append one record, the commit byte last so a torn write never replays
+static UBYTE flash_journal_append(UBYTE bank, UWORD offset, UBYTE len) {
+    if (!flash_journal_fits(FLASH_JOURNAL_RECORD_SIZE(len))) {
+        if (flash_journal_bank == (FLASH_JOURNAL_BANKS - 1)) return FALSE;
+        flash_journal_bank++;
+        flash_journal_ptr = FLASH_JOURNAL_START;
+    }
+    flash_journal_buf[0] = bank;
+    flash_journal_buf[1] = (UBYTE)offset;
+    flash_journal_buf[2] = (UBYTE)(offset >> 8);
+    flash_journal_buf[3] = len;
+    SWITCH_RAM_BANK(bank, RAM_BANKS_ONLY);
+    memcpy(flash_journal_buf + FLASH_JOURNAL_HEADER_SIZE, (UBYTE *)0xA000u + offset, len);
+
+    flash_prog_bank = FLASH_JOURNAL_ROM_BANK(flash_journal_bank);
+    flash_prog_dest = flash_journal_ptr;
+    flash_prog_src = flash_journal_buf;
+    flash_prog_len = FLASH_JOURNAL_HEADER_SIZE + len;
+    // the cursor moves on even if programming fails, that area is no longer erased
+    flash_journal_ptr += FLASH_JOURNAL_RECORD_SIZE(len);
+    if (!flash_program()) return FALSE;
+    flash_prog_dest += FLASH_JOURNAL_HEADER_SIZE + len;
+    flash_journal_buf[0] = FLASH_JOURNAL_COMMIT;
+    flash_prog_src = flash_journal_buf;
+    flash_prog_len = 1;
+    return flash_program();
+}
+
+UBYTE flash_journal_write(UBYTE bank, const UBYTE *data, UWORD size) BANKED {
+    if ((bank >= SRAM_BANKS_TO_SAVE) || (size == 0)) return FALSE;
+    UBYTE _save = _current_ram_bank;
+    UBYTE res = TRUE;
+    if (flash_journal_broken) {
+        // the log ends in a torn record, start over from what SRAM holds now
+        res = flash_journal_compact();
+    } else {
+        UWORD offset = (UWORD)data - 0xA000u;
+        while (size) {
+            UBYTE len = (size > FLASH_JOURNAL_CHUNK) ? FLASH_JOURNAL_CHUNK : size;
+            if (!flash_journal_append(bank, offset, len)) {
+                // journal full: SRAM already holds the rest of the span, so a full rewrite covers it
+                res = flash_journal_compact();
+                break;
+            }
+            offset += len, size -= len;
+        }
+    }
+    SWITCH_RAM_BANK(_save, RAM_BANKS_AND_FLAGS);
+    return res;
+}
@@ -0,0 +1,108 @@
+        .include "global.s"
+
+        .globl __current_bank
+        .globl _flash_prog_bank
+        .globl _flash_prog_dest
+        .globl _flash_prog_src
+        .globl _flash_prog_len
+
+        .area   _CODE_255
+
+.macro .wb addr, val
+        ld a, val
+        ld (addr), a
+.endm
+
+_flash_program_routine:
+        di
+
+        ldh     a, (#__current_bank)
+        push    af                              ; save current bank
+
+        .wb     #rRAMG, #0x00                   ; disable SRAM
+
+        ld      a, (#_flash_prog_bank)
+        ld      (#rROMB0), a                    ; switch ROM bank
+
+        ld      hl, #_flash_prog_dest
+        ld      a, (hl+)
+        ld      e, a
+        ld      d, (hl)                         ; destination DE
+
+        ld      hl, #_flash_prog_src
+        ld      a, (hl+)
+        ld      h, (hl)
+        ld      l, a                            ; source HL, in WRAM
+
+1$:
+        .wb     #0x0AAA, #0xA9
+        .wb     #0x0555, #0x56
+        .wb     #0x0AAA, #0xA0                  ; perform magic
+
+        ld      a, (hl+)
+        ld      b, a
+        ld      (de), a                         ; write byte
+
+        ld      c, #0                           ; wait counter
+2$:
+        ld      a, (de)
+        cp      b
+        jr      z, 3$                           ; check byte
+
+        push    hl
+        pop     hl
+        push    hl
+        pop     hl                              ; delay 4+3+4+3=14
+
+        dec     c
+        jr      nz, 2$
+
+        ld      e, #0                           ; fail
+        jr      5$
+3$:
+        inc     de                              ; next destination
+
+        ld      a, (#_flash_prog_len)
+        dec     a
+        ld      (#_flash_prog_len), a
+        jr      nz, 1$                          ; until all bytes are written
+
+        ld      e, #1                           ; success
+5$:
+        .wb     #0x4000, #0xF0                  ; reset?
+
+        .wb     #rRAMG, #0x0A                   ; enable SRAM back
+
+        pop     af
+        ld      (#rROMB0), a                    ; restore bank
+
+        ei
+
+        ret
+_end_flash_program_routine:
+
+.globl b_flash_program
+b_flash_program = 255
+_flash_program::
+        lda     hl, 0(sp)
+        ld      d, h
+        ld      e, l                            ; de = sp
+
+        ld      hl, #(_flash_program_routine - _end_flash_program_routine)
+        add     hl, sp
+        ld      sp, hl                          ; allocate ram on stack for the routine
+
+        push    de
+        push    hl
+
+        ld      c, #(_end_flash_program_routine - _flash_program_routine)
+        ld      de, #_flash_program_routine
+        rst     0x30                            ; copy up to 256 bytes in C from DE to HL
+
+        pop     hl
+        rst     0x20                            ; call routine on stack using call hl
+
+        pop     hl
+        ld      sp, hl
+
+        ret
@@ -0,0 +1,74 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+
+#include "hdma.h"
+#include "bankdata.h"
+
+// HDMA can't read banked ROM safely (ISRs switch banks mid transfer), so data
+// is staged in WRAM. The raw array is over-allocated and aligned at runtime
+static UBYTE hdma_stage_raw[HDMA_STAGE_SIZE * 2 + HDMA_BLOCK - 1];
+#define HDMA_STAGE(n) ((UBYTE *)((((UWORD)hdma_stage_raw) + (HDMA_BLOCK - 1)) & ~(UWORD)(HDMA_BLOCK - 1)) + ((n) * HDMA_STAGE_SIZE))
+
+static UBYTE hdma_row_buf;
+
+static void hdma_start(UBYTE *vram, const UBYTE *src, UWORD len) {
+    HDMA1_REG = (UBYTE)((UWORD)src >> 8);
+    HDMA2_REG = (UBYTE)(UWORD)src;
+    HDMA3_REG = (UBYTE)((UWORD)vram >> 8);
+    HDMA4_REG = (UBYTE)(UWORD)vram;
+    // general purpose DMA halts the CPU until done, only safe with the LCD off
+    HDMA5_REG = (UBYTE)((len >> 4) - 1) | ((LCDC_REG & LCDCF_ON) ? HDMA_HBLANK : HDMA_GENERAL);
+}
+
+void hdma_wait(void) BANKED {
+    while (hdma_busy());
+}
+
+void hdma_copy(UBYTE *vram, const UBYTE *src, UWORD len, UBYTE bank) BANKED {
+    UBYTE buf = 0;
+    while (len) {
+        UWORD chunk = (len > HDMA_STAGE_SIZE) ? HDMA_STAGE_SIZE : len;
+        UBYTE *stage = HDMA_STAGE(buf);
+        // fill one buffer while the other one is still going out
+        MemcpyBanked(stage, src, chunk, bank);
+        hdma_wait();
+        hdma_start(vram, stage, chunk);
+        vram += chunk, src += chunk, len -= chunk;
+        buf ^= 1;
+    }
+    hdma_wait();
+}
+
+void hdma_set_bkg_data(UBYTE first, UBYTE n, const UBYTE *data, UBYTE bank) BANKED {
+#ifdef CGB
+    if (_is_CGB) {
+        while (n) {
+            UBYTE count = n;
+            UBYTE *vram;
+            // 0x8800 addressing: tiles 0-127 live at 0x9000, 128-255 at 0x8800
+            if (first & 0x80) {
+                vram = (UBYTE *)0x8800 + ((UWORD)(first & 0x7F) << 4);
+            } else {
+                vram = (UBYTE *)0x9000 + ((UWORD)first << 4);
+                if (count > (UBYTE)(128 - first)) count = 128 - first;
+            }
+            hdma_copy(vram, data, (UWORD)count << 4, bank);
+            first += count, n -= count, data += (UWORD)count << 4;
+        }
+        return;
+    }
+#endif
+    SetBankedBkgData(first, n, data, bank);
+}
+
+UBYTE *hdma_row_begin(void) BANKED {
+    return HDMA_STAGE(hdma_row_buf);
+}
+
+void hdma_row_commit(UBYTE y) BANKED {
+    // the other buffer may still be in flight
+    hdma_wait();
+    hdma_start(HDMA_BKG_MAP + ((UWORD)(y & 31) << 5), HDMA_STAGE(hdma_row_buf), HDMA_ROW_SIZE);
+    hdma_row_buf ^= 1;
+}
@@ -0,0 +1,98 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "job.h"
+#include "vm.h"
+
+// 144 visible + 10 vblank lines
+#define JOB_LINES_PER_FRAME 154
+
+job_t jobs[MAX_JOBS];
+UBYTE jobs_active;
+
+void jobs_init(void) BANKED {
+    job_t * job = jobs;
+    for (UBYTE i = MAX_JOBS; i != 0; i--, job++) {
+        if (job->fn && job->cancel) FAR_CALL_EX(job->cancel, job->cancel_bank, JOB_STEP_FN, job->step);
+    }
+    memset(jobs, 0, sizeof(jobs));
+    jobs_active = 0;
+}
+
+UBYTE job_start(UBYTE bank, void * fn) BANKED {
+    UBYTE free_slot = JOB_NONE;
+    job_t * job = jobs;
+    for (UBYTE i = 0; i < MAX_JOBS; i++, job++) {
+        if (job->fn == fn && job->fn_bank == bank) {
+            job->step = 0;
+            return i;
+        }
+        if (job->fn == NULL && free_slot == JOB_NONE) free_slot = i;
+    }
+    if (free_slot == JOB_NONE) return JOB_NONE;
+
+    job = jobs + free_slot;
+    job->fn = fn;
+    job->fn_bank = bank;
+    job->step = 0;
+    job->cancel = NULL, job->cancel_bank = 0;
+    jobs_active++;
+    return free_slot;
+}
+
+void job_set_cancel(UBYTE id, UBYTE bank, void * fn) BANKED {
+    if (id >= MAX_JOBS) return;
+    jobs[id].cancel = fn;
+    jobs[id].cancel_bank = bank;
+}
+
+UBYTE job_is_running(UBYTE id) BANKED {
+    if (id == JOB_ALL) return (jobs_active != 0);
+    if (id >= MAX_JOBS) return FALSE;
+    return (jobs[id].fn != NULL);
+}
+
+static UBYTE job_lines_since(UBYTE start) {
+    UBYTE line = LY_REG;
+    return (line >= start) ? (line - start) : (line + (JOB_LINES_PER_FRAME - start));
+}
+
+void jobs_update(void) BANKED {
+    if (!jobs_active) return;
+
+    UBYTE start = LY_REG;
+    UBYTE stepped = 0;
+    // slots that yielded this frame, one bit each
+    UBYTE yielded = 0, yielded_count = 0;
+    job_t * job = jobs;
+    UBYTE i = 0, bit = 1;
+    // round-robin over the slots; stop once the budget is spent and every job got a step
+    while (jobs_active) {
+        if (job->fn && !(yielded & bit)) {
+            UBYTE result = FAR_CALL_EX(job->fn, job->fn_bank, JOB_STEP_FN, job->step);
+            if (result == JOB_DONE) {
+                job->fn = NULL, job->fn_bank = 0;
+                job->cancel = NULL, job->cancel_bank = 0;
+                jobs_active--;
+            } else {
+                job->step++;
+                if (result == JOB_YIELD) yielded |= bit, yielded_count++;
+            }
+            if (yielded_count == jobs_active) return;
+            if (stepped < MAX_JOBS) stepped++;
+            if ((stepped >= jobs_active) && (job_lines_since(start) >= JOB_SCANLINE_BUDGET)) return;
+        }
+        if (++i == MAX_JOBS) i = 0, bit = 1, job = jobs; else bit <<= 1, job++;
+    }
+}
+
+void vm_job_wait(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    UBYTE id = *(UBYTE *)VM_REF_TO_PTR(FN_ARG0);
+    if (job_is_running(id)) {
+        // call the native again next frame
+        THIS->waitable = TRUE;
+        THIS->PC -= INSTRUCTION_SIZE + sizeof(UBYTE) + sizeof(void *);
+    }
+}
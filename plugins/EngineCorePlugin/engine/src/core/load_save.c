@@ -0,0 +1,372 @@
+#pragma bank 255
+
+#include <string.h>
+
+#include "load_save.h"
+
+#include "system.h"
+#include "actor.h"
+#include "vm.h"
+#include "vm_sleep.h"
+#include "events.h"
+#include "music_manager.h"
+#include "data_manager.h"
+#include "data/states_defines.h"
+#ifdef BATTERYLESS
+    #include "bankdata.h"
+    #include "flasher.h"
+    #include "flash_journal.h"
+#endif
+
+// Pack the mostly empty variables and actors
+#ifndef SAVE_PACK
+#define SAVE_PACK 1
+#endif
+// Slot size in bytes; 0 sizes slots for the worst case, so every save fits
+#ifndef SAVE_SLOT_SIZE
+#define SAVE_SLOT_SIZE 0
+#endif
+
+#define SIGN_BY_PTR(ptr) *((UINT32 *)(ptr))
+extern const UINT32 save_signature;
+// Mixed into the project signature so saves in the stock layout are rejected
+#define SAVE_FORMAT_TAG 0x53564632ul
+#define SAVE_SIGNATURE (save_signature ^ SAVE_FORMAT_TAG)
+
+// Zero-run packing: a token below SAVE_ZERO_RUN is followed by token + 1
+// literal bytes, a token from SAVE_ZERO_RUN up stands for (token & 0x7F) + 1 zeros
+#define SAVE_ZERO_RUN 0x80
+#define SAVE_RUN_MAX 128
+// Worst case packed size: one token per SAVE_RUN_MAX literal bytes
+#define SAVE_PACKED_MAX(size) ((size) + ((size) + SAVE_RUN_MAX - 1) / SAVE_RUN_MAX)
+
+typedef struct save_point_t {
+    void * target;
+    size_t size;
+    UBYTE packed;
+} save_point_t;
+
+#define SAVEPOINT(A) {&(A), sizeof(A), FALSE}
+#if SAVE_PACK
+    #define SAVEPOINT_PACKED(A) {&(A), sizeof(A), TRUE}
+#else
+    #define SAVEPOINT_PACKED(A) SAVEPOINT(A)
+#endif
+#define SAVEPOINTS_END {0, 0, FALSE}
+
+// One per save point, after the signature; the slot then holds the unpacked
+// points at fixed offsets followed by the packed ones back to back, so a
+// packed point changing length never moves an unpacked one
+typedef struct save_header_t {
+    UWORD length;
+    UWORD hash;
+} save_header_t;
+
+extern uint16_t __rand_seed;
+
+const save_point_t save_points[] = {
+    // variables (must be first, need for peeking)
+    SAVEPOINT_PACKED(script_memory),
+    // VM contexts
+    SAVEPOINT(CTXS),
+    SAVEPOINT(first_ctx), SAVEPOINT(free_ctxs), SAVEPOINT(old_executing_ctx), SAVEPOINT(executing_ctx), SAVEPOINT(vm_lock_state),
+    SAVEPOINT(last_ctx), SAVEPOINT(vm_sleep_head), SAVEPOINT(vm_sleep_next), SAVEPOINT(vm_sleep_prev), SAVEPOINT(vm_sleep_delta),
+    // intupt events
+    SAVEPOINT(input_events), SAVEPOINT(input_slots),
+    // timers
+    SAVEPOINT(timer_events), SAVEPOINT(timer_values),
+    // music
+    SAVEPOINT(music_current_track_bank),
+    SAVEPOINT(music_current_track),
+    SAVEPOINT(music_events),
+    // scene
+    SAVEPOINT(current_scene), SAVEPOINT(scene_stack_ptr), SAVEPOINT(scene_stack),
+    // actors
+    SAVEPOINT_PACKED(actors),
+    SAVEPOINT(actors_active_head), SAVEPOINT(actors_inactive_head), SAVEPOINT(player_moving), SAVEPOINT(player_collision_actor),
+    // system
+    SAVEPOINT(__rand_seed),
+    // terminator
+    SAVEPOINTS_END
+};
+
+#ifdef BATTERYLESS
+    extern void _start_save;
+#endif
+
+// Slot size, fixed for the build
+size_t save_blob_size;
+static UBYTE save_slots_per_bank;
+static UBYTE save_points_count;
+// Slot offset of the first packed point
+static UWORD save_packed_offset;
+
+// Writer state: bytes are only stored when they differ from the slot,
+// and the span of changed bytes is kept
+static UBYTE * save_ptr;
+static UBYTE save_measure;
+static UBYTE * save_dirty_lo, * save_dirty_hi;
+// Fletcher-16 with mod 256 sums, over the unpacked bytes of a point
+static UBYTE save_sum1, save_sum2;
+
+// Reader state for unpacking
+static UBYTE * save_out;
+static UWORD save_skip, save_left;
+
+static void save_hash_reset(void) {
+    save_sum1 = save_sum2 = 0;
+}
+
+static void save_hash(UBYTE value) {
+    save_sum1 += value;
+    save_sum2 += save_sum1;
+}
+
+static void save_put(UBYTE value) {
+    if (!save_measure) {
+        if (*save_ptr != value) {
+            *save_ptr = value;
+            if (save_ptr < save_dirty_lo) save_dirty_lo = save_ptr;
+            if (save_ptr >= save_dirty_hi) save_dirty_hi = save_ptr + 1;
+        }
+    }
+    save_ptr++;
+}
+
+static void save_put_raw(const UBYTE * src, UWORD size) {
+    for (; size != 0; size--, src++) {
+        save_hash(*src);
+        save_put(*src);
+    }
+}
+
+static void save_put_packed(const UBYTE * src, UWORD size) {
+    while (size) {
+        UBYTE n = 0;
+        if (*src == 0) {
+            while ((size) && (*src == 0) && (n != SAVE_RUN_MAX)) {
+                save_hash(0);
+                n++, src++, size--;
+            }
+            save_put(SAVE_ZERO_RUN | (n - 1));
+        } else {
+            // single zeros stay in the literal run, a pair ends it
+            const UBYTE * run = src;
+            while ((size) && (n != SAVE_RUN_MAX) && !((size > 1) && (src[0] == 0) && (src[1] == 0))) {
+                n++, src++, size--;
+            }
+            save_put(n - 1);
+            for (; n != 0; n--, run++) {
+                save_hash(*run);
+                save_put(*run);
+            }
+        }
+    }
+}
+
+static void save_emit(UBYTE value) {
+    if (save_skip) {
+        save_skip--;
+        return;
+    }
+    if (!save_left) return;
+    save_left--;
+    save_hash(value);
+    if (save_out) *save_out++ = value;
+}
+
+/**
+ * Unpack a packed point. Output goes to save_out (when not NULL) after
+ * save_skip bytes, for at most save_left bytes, and into the hash.
+ *
+ * @param src Packed data in SRAM
+ * @param length Packed length
+ * @return Number of unpacked bytes the data holds
+ */
+static UWORD save_unpack(const UBYTE * src, UWORD length) {
+    UWORD total = 0;
+    while (length) {
+        UBYTE token = *src++;
+        length--;
+        UBYTE n = (token & (SAVE_ZERO_RUN - 1)) + 1;
+        total += n;
+        if (token & SAVE_ZERO_RUN) {
+            for (; n != 0; n--) save_emit(0);
+        } else {
+            if (n > length) return 0;
+            length -= n;
+            for (; n != 0; n--) save_emit(*src++);
+        }
+    }
+    return total;
+}
+
+void data_init(void) BANKED {
+    ENABLE_RAM_MBC5;
+    SWITCH_RAM_BANK(0, RAM_BANKS_ONLY);
+    // calculate slot layout
+    UWORD raw_size = 0, packed_size = 0;
+    save_points_count = 0;
+    for(const save_point_t * point = save_points; (point->target); point++) {
+        save_points_count++;
+        if (point->packed) {
+            packed_size += SAVE_PACKED_MAX(point->size);
+        } else {
+            raw_size += point->size;
+        }
+    }
+    save_packed_offset = sizeof(save_signature) + (save_points_count * sizeof(save_header_t)) + raw_size;
+    save_blob_size = save_packed_offset + packed_size;
+#if SAVE_SLOT_SIZE
+    // a smaller slot relies on the packed points compressing; saves that don't fit are refused
+    if ((SAVE_SLOT_SIZE > save_packed_offset) && (SAVE_SLOT_SIZE < save_blob_size)) save_blob_size = SAVE_SLOT_SIZE;
+#endif
+    save_slots_per_bank = SRAM_BANK_SIZE / save_blob_size;
+#ifdef BATTERYLESS
+    // load from FLASH ROM
+    for (UBYTE i = 0; i < SRAM_BANKS_TO_SAVE; i++) restore_sram_bank(i);
+    // then the writes made since the mirrors were last rewritten
+    flash_journal_replay();
+#endif
+}
+
+UBYTE * data_slot_address(UBYTE slot, UBYTE *bank) {
+    if (save_slots_per_bank == 0) return NULL;
+    UBYTE res_bank = slot / save_slots_per_bank;
+    if (res_bank >= SRAM_BANKS_TO_SAVE) return NULL;
+    *bank = res_bank;
+    return (UBYTE *)0xA000u + (UWORD)(slot - (res_bank * save_slots_per_bank)) * save_blob_size;
+}
+
+/**
+ * Write every save point into a slot, or only measure them.
+ *
+ * @param save_data Slot address
+ * @param measure TRUE to leave the slot alone and only size the data
+ * @return Slot bytes used
+ */
+static UWORD data_write_points(UBYTE * save_data, UBYTE measure) {
+    save_measure = measure;
+    save_header_t * header = (save_header_t *)(save_data + sizeof(save_signature));
+    UBYTE * raw = save_data + sizeof(save_signature) + (save_points_count * sizeof(save_header_t));
+    UBYTE * packed = save_data + save_packed_offset;
+    save_header_t entry;
+    for(const save_point_t * point = save_points; (point->target); point++, header++) {
+        save_hash_reset();
+        if (point->packed) {
+            save_ptr = packed;
+            save_put_packed(point->target, point->size);
+            entry.length = save_ptr - packed;
+            packed = save_ptr;
+        } else {
+            save_ptr = raw;
+            save_put_raw(point->target, point->size);
+            entry.length = point->size;
+            raw = save_ptr;
+        }
+        entry.hash = ((UWORD)save_sum2 << 8) | save_sum1;
+        save_ptr = (UBYTE *)header;
+        save_put_raw((UBYTE *)&entry, sizeof(entry));
+    }
+    return packed - save_data;
+}
+
+void data_save(UBYTE slot) BANKED {
+    UBYTE data_bank, *save_data = data_slot_address(slot, &data_bank);
+    if (save_data == NULL) return;
+    SWITCH_RAM_BANK(data_bank, RAM_BANKS_ONLY);
+
+#if SAVE_SLOT_SIZE
+    // keep the previous save rather than write one that doesn't fit
+    if (data_write_points(save_data, TRUE) > save_blob_size) return;
+#endif
+    save_dirty_lo = (UBYTE *)0xFFFFu, save_dirty_hi = NULL;
+    data_write_points(save_data, FALSE);
+    save_measure = FALSE;
+    save_ptr = save_data;
+    UINT32 signature = SAVE_SIGNATURE;
+    for (UBYTE i = 0; i != sizeof(signature); i++) save_put(((UBYTE *)&signature)[i]);
+#ifdef BATTERYLESS
+    // journal the changed bytes to FLASH ROM, unless the slot already held this state
+    if (save_dirty_hi) flash_journal_write(data_bank, save_dirty_lo, save_dirty_hi - save_dirty_lo);
+#endif
+}
+
+// Check every point's hash, so a torn or stale slot is never half loaded
+static UBYTE data_verify(UBYTE * save_data) {
+    const save_header_t * header = (save_header_t *)(save_data + sizeof(save_signature));
+    const UBYTE * raw = save_data + sizeof(save_signature) + (save_points_count * sizeof(save_header_t));
+    const UBYTE * packed = save_data + save_packed_offset;
+    for(const save_point_t * point = save_points; (point->target); point++, header++) {
+        save_hash_reset();
+        if (point->packed) {
+            if ((packed + header->length) > (save_data + save_blob_size)) return FALSE;
+            save_out = NULL, save_skip = 0, save_left = point->size;
+            if (save_unpack(packed, header->length) != point->size) return FALSE;
+            packed += header->length;
+        } else {
+            for (UWORD i = point->size; i != 0; i--) save_hash(*raw++);
+        }
+        if (header->hash != (((UWORD)save_sum2 << 8) | save_sum1)) return FALSE;
+    }
+    return TRUE;
+}
+
+UBYTE data_load(UBYTE slot) BANKED {
+    UBYTE data_bank, *save_data = data_slot_address(slot, &data_bank);
+    if (save_data == NULL) return FALSE;
+    SWITCH_RAM_BANK(data_bank, RAM_BANKS_ONLY);
+    if (SIGN_BY_PTR(save_data) != SAVE_SIGNATURE) return FALSE;
+    if (!data_verify(save_data)) return FALSE;
+
+    const save_header_t * header = (save_header_t *)(save_data + sizeof(save_signature));
+    const UBYTE * raw = save_data + sizeof(save_signature) + (save_points_count * sizeof(save_header_t));
+    const UBYTE * packed = save_data + save_packed_offset;
+    for(const save_point_t * point = save_points; (point->target); point++, header++) {
+        if (point->packed) {
+            save_out = point->target, save_skip = 0, save_left = point->size;
+            save_unpack(packed, header->length);
+            packed += header->length;
+        } else {
+            memcpy(point->target, raw, point->size);
+            raw += point->size;
+        }
+    }
+    // Restart music
+    if (music_current_track_bank != MUSIC_STOP_BANK) {
+        music_next_track = music_current_track;
+    } else {
+        music_sound_cut();
+    }
+    return TRUE;
+}
+
+void data_clear(UBYTE slot) BANKED {
+    UBYTE data_bank, *save_data = data_slot_address(slot, &data_bank);
+    if (save_data == NULL) return;
+    SWITCH_RAM_BANK(data_bank, RAM_BANKS_ONLY);
+    if (SIGN_BY_PTR(save_data) == 0) return;
+    SIGN_BY_PTR(save_data) = 0;
+#ifdef BATTERYLESS
+    // journal the cleared signature to FLASH ROM
+    flash_journal_write(data_bank, save_data, sizeof(save_signature));
+#endif
+}
+
+UBYTE data_peek(UBYTE slot, UINT16 idx, UWORD count, UINT16 * dest) BANKED {
+    UBYTE data_bank, *save_data = data_slot_address(slot, &data_bank);
+    if (save_data == NULL) return FALSE;
+    SWITCH_RAM_BANK(data_bank, RAM_BANKS_ONLY);
+    if (SIGN_BY_PTR(save_data) != SAVE_SIGNATURE) return FALSE;
+
+    if (count == 0) return TRUE;
+    // script_memory is the first save point
+    if (!save_points[0].packed) {
+        memcpy(dest, save_data + sizeof(save_signature) + (save_points_count * sizeof(save_header_t)) + (idx << 1), count << 1);
+        return TRUE;
+    }
+    const save_header_t * header = (save_header_t *)(save_data + sizeof(save_signature));
+    save_out = (UBYTE *)dest, save_skip = idx << 1, save_left = count << 1;
+    save_unpack(save_data + save_packed_offset, header->length);
+    return TRUE;
+}
@@ -0,0 +1,35 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+
+#include "native_batch.h"
+#include "vm.h"
+#include "bankdata.h"
+
+void vm_call_native_batch(SCRIPT_CTX * THIS) OLDCALL BANKED {
+    native_batch_call_t call;
+    INT16 args[NATIVE_BATCH_MAX_ARGS];
+    const UBYTE * pc = THIS->PC;
+    UBYTE count = ReadBankedUBYTE(pc++, THIS->bank);
+
+    for (; count != 0; count--) {
+        MemcpyBanked(&call, pc, sizeof(call), THIS->bank);
+        pc += sizeof(call);
+        UBYTE nargs = (call.nargs > NATIVE_BATCH_MAX_ARGS) ? NATIVE_BATCH_MAX_ARGS : call.nargs;
+        MemcpyBanked(args, pc, nargs << 1, THIS->bank);
+        pc += call.nargs << 1;
+
+        // resolve references before pushing, since stack relative ones move with the pushes
+        UBYTE mask = call.varmask;
+        for (UBYTE i = 0; i != nargs; i++, mask >>= 1) {
+            if (mask & 1) args[i] = *(INT16 *)VM_REF_TO_PTR(args[i]);
+        }
+        // ARG0 ends up on top, as if pushed last by the event
+        for (UBYTE i = nargs; i != 0; i--) {
+            *(THIS->stack_ptr++) = args[i - 1];
+        }
+        FAR_CALL_EX((void *)call.fn, call.bank, SCRIPT_NATIVE_FN, THIS);
+        THIS->stack_ptr -= nargs;
+    }
+    THIS->PC = pc;
+}
@@ -0,0 +1,26 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+
+#include "scene_header.h"
+#include "bankdata.h"
+
+scene_header_t scene_header_cache[SCENE_HEADER_CACHE_SIZE];
+static UBYTE scene_header_next;
+
+const scene_header_t *scene_header_get(UBYTE bank, const scene_t *scene) BANKED {
+    scene_header_t *entry = scene_header_cache;
+    for (UBYTE i = SCENE_HEADER_CACHE_SIZE; i != 0; i--, entry++) {
+        if ((entry->scene_ptr == scene) && (entry->scene_bank == bank)) return entry;
+    }
+
+    entry = scene_header_cache + scene_header_next;
+    scene_header_next = (scene_header_next + 1) & (SCENE_HEADER_CACHE_SIZE - 1);
+    scene_t scn;
+    MemcpyBanked(&scn, scene, sizeof(scn), bank);
+    MemcpyBanked(&entry->background, scn.background.ptr, sizeof(entry->background), scn.background.bank);
+    entry->collisions = scn.collisions;
+    entry->scene_bank = bank;
+    entry->scene_ptr = scene;
+    return entry;
+}
@@ -0,0 +1,136 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "scene_stream.h"
+#include "bankdata.h"
+#include "job.h"
+
+BANKREF(SCENE_STREAM)
+
+#define BIT_TEST(mask, i) ((mask)[(i) >> 3] & (1 << ((i) & 7)))
+#define BIT_SET(mask, i) ((mask)[(i) >> 3] |= (1 << ((i) & 7)))
+#define BIT_CLEAR(mask, i) ((mask)[(i) >> 3] &= ~(1 << ((i) & 7)))
+
+UBYTE scene_ready;
+UBYTE scene_stream_left;
+UBYTE scene_stream_sprite_pending[SCENE_STREAM_SPRITE_BYTES];
+UBYTE scene_stream_actor_pending[SCENE_STREAM_ACTOR_BYTES];
+UBYTE scene_stream_actor_sprite[MAX_ACTORS];
+UBYTE scene_stream_projectile_sprite[MAX_PROJECTILE_DEFS];
+
+static far_ptr_t scene_stream_sprites;
+// Next sprite, then actor, the job looks at
+static UBYTE scene_stream_cursor;
+
+void scene_stream_reset(UBYTE bank, const far_ptr_t *sprites) BANKED {
+    memset(scene_stream_sprite_pending, 0, sizeof(scene_stream_sprite_pending));
+    memset(scene_stream_actor_pending, 0, sizeof(scene_stream_actor_pending));
+    memset(scene_stream_actor_sprite, SCENE_STREAM_NONE, sizeof(scene_stream_actor_sprite));
+    memset(scene_stream_projectile_sprite, SCENE_STREAM_NONE, sizeof(scene_stream_projectile_sprite));
+    scene_stream_sprites.bank = bank;
+    scene_stream_sprites.ptr = (void *)sprites;
+    scene_stream_left = scene_stream_cursor = 0;
+    scene_ready = TRUE;
+}
+
+UBYTE scene_stream_sprite_tiles(const spritesheet_t *sprite, UBYTE bank) BANKED {
+    far_ptr_t data;
+    ReadBankedFarPtr(&data, (void *)&sprite->tileset, bank);
+    UBYTE n_tiles = ReadBankedUBYTE(&((tileset_t *)data.ptr)->n_tiles, data.bank);
+#ifdef CGB
+    if (_is_CGB) {
+        ReadBankedFarPtr(&data, (void *)&sprite->cgb_tileset, bank);
+        if (data.ptr) {
+            UBYTE n_cgb_tiles = ReadBankedUBYTE(&((tileset_t *)data.ptr)->n_tiles, data.bank);
+            if (n_cgb_tiles > n_tiles) return n_cgb_tiles;
+        }
+    }
+#endif
+    return n_tiles;
+}
+
+void scene_stream_queue_sprite(UBYTE idx) BANKED {
+    if (BIT_TEST(scene_stream_sprite_pending, idx)) return;
+    BIT_SET(scene_stream_sprite_pending, idx);
+    scene_stream_left++;
+}
+
+void scene_stream_queue_actor(actor_t *actor) BANKED {
+    UBYTE idx = actor - actors;
+    if (BIT_TEST(scene_stream_actor_pending, idx)) return;
+    BIT_SET(scene_stream_actor_pending, idx);
+    scene_stream_left++;
+}
+
+void scene_stream_start(void) BANKED {
+    if (scene_stream_left == 0) {
+        scene_ready = TRUE;
+        return;
+    }
+    scene_ready = FALSE;
+    if (job_start(BANK(SCENE_STREAM), (void *)scene_stream_step) == JOB_NONE) {
+        // No free slot: upload everything now, like the stock loader
+        scene_stream_flush();
+    }
+}
+
+void scene_stream_sprite(UBYTE idx) BANKED {
+    if ((idx == SCENE_STREAM_NONE) || !BIT_TEST(scene_stream_sprite_pending, idx)) return;
+    BIT_CLEAR(scene_stream_sprite_pending, idx);
+
+    far_ptr_t sprite;
+    ReadBankedFarPtr(&sprite, (UBYTE *)((far_ptr_t *)scene_stream_sprites.ptr + idx), scene_stream_sprites.bank);
+    load_sprite(scene_sprites_base_tiles[idx], sprite.ptr, sprite.bank);
+    if (--scene_stream_left == 0) scene_ready = TRUE;
+}
+
+static void scene_stream_exclusive(UBYTE idx) {
+    if (!BIT_TEST(scene_stream_actor_pending, idx)) return;
+    BIT_CLEAR(scene_stream_actor_pending, idx);
+
+    actor_t *actor = actors + idx;
+    load_sprite(actor->base_tile, actor->sprite.ptr, actor->sprite.bank);
+    if (--scene_stream_left == 0) scene_ready = TRUE;
+}
+
+void scene_stream_actor(actor_t *actor) BANKED {
+    UBYTE idx = actor - actors;
+    scene_stream_exclusive(idx);
+    scene_stream_sprite(scene_stream_actor_sprite[idx]);
+}
+
+void scene_stream_flush(void) BANKED {
+    while (scene_stream_left) scene_stream_step(0);
+}
+
+UBYTE scene_stream_step(UBYTE step) OLDCALL BANKED {
+    step;
+    // uploads made on demand leave holes, so scan forward to the next pending one
+    while (scene_stream_left) {
+        UBYTE i = scene_stream_cursor++;
+        if (i < MAX_SCENE_SPRITES) {
+            if (BIT_TEST(scene_stream_sprite_pending, i)) {
+                scene_stream_sprite(i);
+                break;
+            }
+        } else if ((UBYTE)(i - MAX_SCENE_SPRITES) < MAX_ACTORS) {
+            if (BIT_TEST(scene_stream_actor_pending, (UBYTE)(i - MAX_SCENE_SPRITES))) {
+                scene_stream_exclusive(i - MAX_SCENE_SPRITES);
+                break;
+            }
+        } else {
+            scene_stream_cursor = 0;
+        }
+    }
+    return (scene_stream_left == 0);
+}
+
+void vm_scene_wait_ready(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    if (!scene_ready) {
+        // call the native again next frame
+        THIS->waitable = TRUE;
+        THIS->PC -= INSTRUCTION_SIZE + sizeof(UBYTE) + sizeof(void *);
+    }
+}
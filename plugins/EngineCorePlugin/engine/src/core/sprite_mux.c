@@ -0,0 +1,78 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "sprite_mux.h"
+#include "vm.h"
+
+sprite_mux_entry_t sprite_mux_entries[MAX_ACTORS];
+UBYTE sprite_mux_len;
+UBYTE sprite_mux_order[MAX_ACTORS];
+UBYTE sprite_mux_start;
+
+UBYTE sprite_mux_dropped;
+UBYTE sprite_mux_peak;
+UWORD sprite_mux_overloads;
+
+// Entry drawn first on the next overloaded frame
+static UBYTE sprite_mux_phase;
+
+void sprite_mux_init(void) BANKED {
+    sprite_mux_len = sprite_mux_start = sprite_mux_phase = 0;
+    sprite_mux_dropped = sprite_mux_peak = 0;
+    sprite_mux_overloads = 0;
+}
+
+void sprite_mux_sort(UBYTE reserved) BANKED {
+    // one extra band so band b + 1 is always readable
+    UBYTE band_pos[SPRITE_MUX_BANDS];
+    UBYTE band_load[SPRITE_MUX_BANDS + 1];
+    memset(band_pos, 0, sizeof(band_pos));
+    memset(band_load, 0, sizeof(band_load));
+
+    // counting pass: entries and hardware sprites per band
+    UWORD total = reserved;
+    sprite_mux_entry_t *entry = sprite_mux_entries;
+    for (UBYTE i = sprite_mux_len; i != 0; i--, entry++) {
+        UBYTE band = entry->y >> SPRITE_MUX_BAND_SHIFT;
+        band_pos[band]++;
+        band_load[band] += entry->count;
+        total += entry->count;
+    }
+
+    // band start offsets, and the busiest line on the way
+    UBYTE pos = 0, peak = 0;
+    for (UBYTE band = 0; band != SPRITE_MUX_BANDS; band++) {
+        UBYTE n = band_pos[band];
+        band_pos[band] = pos;
+        pos += n;
+        UBYTE load = band_load[band] + band_load[band + 1];
+        if (load > peak) peak = load;
+    }
+    sprite_mux_peak = peak;
+    sprite_mux_start = 0;
+
+    if ((peak <= SPRITE_MUX_LINE_LIMIT) && (total <= SPRITE_MUX_BUDGET)) {
+        // everything fits: keep list order, so PLAYER is drawn first and stays on top
+        for (UBYTE i = 0; i != sprite_mux_len; i++) sprite_mux_order[i] = i;
+        return;
+    }
+
+    // placement pass; stable, so an unchanged scene keeps an unchanged order
+    entry = sprite_mux_entries;
+    for (UBYTE i = 0; i != sprite_mux_len; i++, entry++) {
+        sprite_mux_order[band_pos[entry->y >> SPRITE_MUX_BAND_SHIFT]++] = i;
+    }
+
+    sprite_mux_overloads++;
+    if (++sprite_mux_phase >= sprite_mux_len) sprite_mux_phase = 0;
+    sprite_mux_start = sprite_mux_phase;
+}
+
+void vm_sprite_mux_get_stats(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    INT16 dest = *(INT16 *)VM_REF_TO_PTR(FN_ARG0);
+    script_memory[dest] = sprite_mux_dropped;
+    script_memory[dest + 1] = sprite_mux_peak;
+    script_memory[dest + 2] = sprite_mux_overloads;
+}
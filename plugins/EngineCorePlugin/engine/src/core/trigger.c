@@ -0,0 +1,200 @@
+#pragma bank 255
+
+#include <string.h>
+
+#include "trigger.h"
+#include "vm.h"
+
+// Triggers are indexed by 16 tile bands on each axis: one bit per trigger
+// in every row band and column band it overlaps
+#define TRIGGER_BAND_SHIFT 4
+#define TRIGGER_BANDS      16
+#define TRIGGER_MASK_BYTES ((MAX_TRIGGERS + 7) >> 3)
+
+trigger_t triggers[MAX_TRIGGERS];
+UBYTE triggers_len = 0;
+UBYTE last_trigger_tx;
+UBYTE last_trigger_ty;
+UBYTE last_trigger;
+
+static UBYTE trigger_col_masks[TRIGGER_BANDS][TRIGGER_MASK_BYTES];
+static UBYTE trigger_row_masks[TRIGGER_BANDS][TRIGGER_MASK_BYTES];
+static UBYTE trigger_candidates[TRIGGER_MASK_BYTES];
+
+static void trigger_index_build(void) {
+    memset(trigger_col_masks, 0, sizeof(trigger_col_masks));
+    memset(trigger_row_masks, 0, sizeof(trigger_row_masks));
+
+    trigger_t *trigger = triggers;
+    for (UBYTE i = 0; i != triggers_len; i++, trigger++) {
+        if ((trigger->width == 0) || (trigger->height == 0)) continue;
+
+        UBYTE byte = i >> 3, bit = 1 << (i & 7);
+        UBYTE last = (trigger->x + trigger->width - 1) >> TRIGGER_BAND_SHIFT;
+        if (last >= TRIGGER_BANDS) last = TRIGGER_BANDS - 1;
+        for (UBYTE band = trigger->x >> TRIGGER_BAND_SHIFT; band <= last; band++) {
+            trigger_col_masks[band][byte] |= bit;
+        }
+        last = (trigger->y + trigger->height - 1) >> TRIGGER_BAND_SHIFT;
+        if (last >= TRIGGER_BANDS) last = TRIGGER_BANDS - 1;
+        for (UBYTE band = trigger->y >> TRIGGER_BAND_SHIFT; band <= last; band++) {
+            trigger_row_masks[band][byte] |= bit;
+        }
+    }
+}
+
+// Fill trigger_candidates with the triggers sharing a band with tiles [tx0, tx1] x [ty0, ty1]
+static void trigger_gather(UBYTE tx0, UBYTE tx1, UBYTE ty0, UBYTE ty1) {
+    UBYTE cols[TRIGGER_MASK_BYTES], rows[TRIGGER_MASK_BYTES];
+
+    // a range that wrapped past tile 255 can't be banded, test every trigger
+    if ((tx1 < tx0) || (ty1 < ty0)) {
+        memset(trigger_candidates, 0xFF, sizeof(trigger_candidates));
+        return;
+    }
+
+    memset(cols, 0, sizeof(cols));
+    memset(rows, 0, sizeof(rows));
+    for (UBYTE band = tx0 >> TRIGGER_BAND_SHIFT; ; band++) {
+        for (UBYTE b = 0; b != TRIGGER_MASK_BYTES; b++) cols[b] |= trigger_col_masks[band][b];
+        if (band == (tx1 >> TRIGGER_BAND_SHIFT)) break;
+    }
+    for (UBYTE band = ty0 >> TRIGGER_BAND_SHIFT; ; band++) {
+        for (UBYTE b = 0; b != TRIGGER_MASK_BYTES; b++) rows[b] |= trigger_row_masks[band][b];
+        if (band == (ty1 >> TRIGGER_BAND_SHIFT)) break;
+    }
+    for (UBYTE b = 0; b != TRIGGER_MASK_BYTES; b++) trigger_candidates[b] = cols[b] & rows[b];
+}
+
+void trigger_reset(void) BANKED {
+    last_trigger_tx = 0;
+    last_trigger_ty = 0;
+    last_trigger = NO_TRIGGER_COLLISON;
+    // load_scene() calls this right after copying the scene triggers
+    trigger_index_build();
+}
+
+void trigger_interact(UBYTE i) BANKED {
+    if (triggers[i].script_flags & TRIGGER_HAS_ENTER_SCRIPT) {
+        script_execute(triggers[i].script.bank, triggers[i].script.ptr, 0, 1, 1);
+    }
+}
+
+UBYTE trigger_activate_at(UBYTE tx, UBYTE ty, UBYTE force) BANKED {
+    UBYTE hit_trigger;
+
+    // Don't reactivate trigger if not changed tile
+    if (!force && ((tx == last_trigger_tx) && (ty == last_trigger_ty))) {
+        return FALSE;
+    }
+
+    hit_trigger = trigger_at_tile(tx, ty);
+    last_trigger_tx = tx;
+    last_trigger_ty = ty;
+
+    if (hit_trigger != NO_TRIGGER_COLLISON) {
+        trigger_interact(hit_trigger);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+UBYTE trigger_at_intersection(bounding_box_t *bb, point16_t *offset) BANKED {
+    UBYTE tile_left   = ((offset->x >> 4) + bb->left)   >> 3;
+    UBYTE tile_right  = ((offset->x >> 4) + bb->right)  >> 3;
+    UBYTE tile_top    = ((offset->y >> 4) + bb->top)    >> 3;
+    UBYTE tile_bottom = ((offset->y >> 4) + bb->bottom) >> 3;
+    UBYTE i;
+
+    trigger_gather(tile_left, tile_right, tile_top, tile_bottom);
+
+    for (i = 0; i < triggers_len; i++) {
+        // skip whole bytes of the candidate mask at once
+        if ((i & 7) == 0 && trigger_candidates[i >> 3] == 0) {
+            i += 7;
+            continue;
+        }
+        if ((trigger_candidates[i >> 3] & (1 << (i & 7))) == 0) continue;
+
+        UBYTE trigger_left   = triggers[i].x;
+        UBYTE trigger_top    = triggers[i].y;
+        UBYTE trigger_right  = triggers[i].x + triggers[i].width  - 1;
+        UBYTE trigger_bottom = triggers[i].y + triggers[i].height - 1;
+
+        if ((tile_left <= trigger_right)
+            && (tile_right >= trigger_left)
+            && (tile_top <= trigger_bottom)
+            && (tile_bottom >= trigger_top)) {
+                return i;
+        }
+    }
+
+    return NO_TRIGGER_COLLISON;
+}
+
+
+UBYTE trigger_activate_at_intersection(bounding_box_t *bb, point16_t *offset, UBYTE force) BANKED {
+    UBYTE hit_trigger = trigger_at_intersection(bb, offset);
+    UBYTE trigger_script_called = FALSE;
+
+    // Don't reactivate trigger if not changed tile
+    if (!force && (last_trigger == hit_trigger)) {
+        return FALSE;
+    }
+
+    if (last_trigger != NO_TRIGGER_COLLISON && 
+        (hit_trigger == NO_TRIGGER_COLLISON || hit_trigger != last_trigger)) {
+        
+        if (hit_trigger != NO_TRIGGER_COLLISON && triggers[hit_trigger].script_flags & TRIGGER_HAS_ENTER_SCRIPT) {
+            script_execute(triggers[hit_trigger].script.bank, triggers[hit_trigger].script.ptr, 0, 1, 1);
+            trigger_script_called = TRUE;
+        }
+
+        if (triggers[last_trigger].script_flags & TRIGGER_HAS_LEAVE_SCRIPT) {
+            script_execute(
+                triggers[last_trigger].script.bank, 
+                triggers[last_trigger].script.ptr, 0, 1, 2);
+            trigger_script_called = TRUE;
+        }
+
+        last_trigger = hit_trigger;
+
+        return trigger_script_called;
+    }
+    
+    last_trigger = hit_trigger;
+
+    if (hit_trigger != NO_TRIGGER_COLLISON && triggers[hit_trigger].script_flags & TRIGGER_HAS_ENTER_SCRIPT) {
+        script_execute(triggers[hit_trigger].script.bank, triggers[hit_trigger].script.ptr, 0, 1, 1);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+UBYTE trigger_at_tile(UBYTE tx_a, UBYTE ty_a) BANKED {
+    UBYTE i, tx_b, ty_b, tx_c, ty_c;
+
+    // matches triggers covering column tx_a or tx_a + 1
+    trigger_gather(tx_a, (tx_a == 255) ? tx_a : tx_a + 1, ty_a, ty_a);
+
+    for (i = 0; i < triggers_len; i++) {
+        if ((i & 7) == 0 && trigger_candidates[i >> 3] == 0) {
+            i += 7;
+            continue;
+        }
+        if ((trigger_candidates[i >> 3] & (1 << (i & 7))) == 0) continue;
+
+        tx_b = triggers[i].x;
+        ty_b = triggers[i].y;
+        tx_c = tx_b + triggers[i].width - 1;
+        ty_c = ty_b + triggers[i].height - 1;
+
+        if ((tx_a + 1) >= tx_b && tx_a <= tx_c && ty_a >= ty_b && ty_a <= ty_c) {
+            return i;
+        }
+    }
+
+    return NO_TRIGGER_COLLISON;
+}
@@ -0,0 +1,101 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "ui_text_cache.h"
+#include "ui.h"
+
+#if UI_TEXT_CACHE_TILES
+
+UBYTE ui_text_cache_pool[UI_TEXT_CACHE_TILES * 16];
+UBYTE ui_text_cache_rec_left;
+UBYTE ui_text_cache_run_len;
+UBYTE ui_text_cache_dry;
+
+static ui_text_cache_entry_t ui_text_cache_entries[UI_TEXT_CACHE_ENTRIES];
+// Characters of each entry's run; the hash only narrows the search down, these decide a hit
+static UBYTE ui_text_cache_chars[UI_TEXT_CACHE_ENTRIES][UI_TEXT_CACHE_TILES];
+// Pool tiles handed out so far; the pool is only reclaimed as a whole
+static UBYTE ui_text_cache_used;
+static UBYTE ui_text_cache_next;
+static UWORD ui_text_cache_hash;
+static UBYTE ui_text_cache_key;
+static const unsigned char *ui_text_cache_text;
+// Where the run being recorded goes
+static UBYTE ui_text_cache_rec_first;
+static UBYTE ui_text_cache_rec_tiles;
+
+void ui_text_cache_reset(void) BANKED {
+    memset(ui_text_cache_entries, 0, sizeof(ui_text_cache_entries));
+    ui_text_cache_used = ui_text_cache_next = 0;
+    ui_text_cache_rec_left = 0;
+}
+
+const ui_text_cache_entry_t *ui_text_cache_find(const unsigned char *text) BANKED {
+    // the font is identified by its bitmaps, which every font has its own of
+    UWORD hash = (UWORD)vwf_current_font_desc.bitmaps ^ vwf_current_font_bank;
+    UBYTE len = 0;
+    ui_text_cache_text = text;
+    while (UI_TEXT_CACHE_IS_CHAR(*text) && (len != UI_TEXT_CACHE_TILES)) {
+        hash = ((hash << 5) | (hash >> 11)) ^ *text++;
+        len++;
+    }
+    ui_text_cache_run_len = len;
+    ui_text_cache_hash = hash;
+    ui_text_cache_key = (text_bkg_fill & 0x01u) | (vwf_direction << 1);
+    if (len < UI_TEXT_CACHE_MIN_RUN) return NULL;
+
+    const ui_text_cache_entry_t *entry = ui_text_cache_entries;
+    for (UBYTE i = 0; i != UI_TEXT_CACHE_ENTRIES; i++, entry++) {
+        if ((entry->len != len) || (entry->hash != hash) || (entry->key != ui_text_cache_key)) continue;
+        if (memcmp(ui_text_cache_chars[i], ui_text_cache_text, len) == 0) return entry;
+    }
+    return NULL;
+}
+
+void ui_text_cache_record_begin(void) BANKED {
+    ui_text_cache_rec_left = 0;
+    UBYTE len = ui_text_cache_run_len;
+    if (len < UI_TEXT_CACHE_MIN_RUN) return;
+    // a glyph is at most 8 pixels wide, so a run never needs more than len + 1 tiles
+    if ((UBYTE)(len + 1) > UI_TEXT_CACHE_TILES) return;
+    if ((UWORD)ui_text_cache_used + len + 1 > UI_TEXT_CACHE_TILES) ui_text_cache_reset();
+    ui_text_cache_rec_first = ui_text_cache_used;
+    ui_text_cache_rec_tiles = 0;
+    ui_text_cache_rec_left = len;
+    // the slot stays free until record_end(), but takes the characters while they are at hand
+    ui_text_cache_entries[ui_text_cache_next].len = 0;
+    memcpy(ui_text_cache_chars[ui_text_cache_next], ui_text_cache_text, len);
+}
+
+void ui_text_cache_record_tile(const UBYTE *tile) BANKED {
+    memcpy(ui_text_cache_pool + ((UWORD)(ui_text_cache_rec_first + ui_text_cache_rec_tiles) << 4), tile, 16);
+    ui_text_cache_rec_tiles++;
+}
+
+void ui_text_cache_record_end(UBYTE offset, const UBYTE *tile) BANKED {
+    if (offset) ui_text_cache_record_tile(tile);
+    ui_text_cache_entry_t *entry = ui_text_cache_entries + ui_text_cache_next;
+    ui_text_cache_next = (ui_text_cache_next + 1) & (UI_TEXT_CACHE_ENTRIES - 1);
+    entry->hash = ui_text_cache_hash;
+    entry->len = ui_text_cache_run_len;
+    entry->key = ui_text_cache_key;
+    entry->first = ui_text_cache_rec_first;
+    entry->tiles = (offset) ? ui_text_cache_rec_tiles - 1 : ui_text_cache_rec_tiles;
+    entry->offset = offset;
+    ui_text_cache_used = ui_text_cache_rec_first + ui_text_cache_rec_tiles;
+}
+
+void vm_ui_text_cache_prerender(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    THIS;
+    ui_text_cache_prerender();
+}
+
+#else
+
+void vm_ui_text_cache_prerender(SCRIPT_CTX *THIS) OLDCALL BANKED {
+    THIS;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include <string.h>
+
+#include "vm_profiler.h"
+#include "system.h"
+#include "bankdata.h"
+
+#if VM_PROFILER
+
+static UBYTE vm_profile_frames;
+
+static void vm_profile_inc(UWORD * counter) {
+    if (*counter != 0xFFFFu) (*counter)++;
+}
+
+static void vm_profile_count_site(vm_profile_record_t * rec, vm_profile_site_t * sites, UBYTE mask, UBYTE bank, UWORD addr) {
+    UBYTE slot = ((UBYTE)(addr >> VM_PROFILE_REGION_SHIFT) ^ (UBYTE)(addr >> 8) ^ bank) & mask;
+    for (UBYTE i = VM_PROFILE_PROBES; i != 0; i--, slot = (slot + 1) & mask) {
+        vm_profile_site_t * site = sites + slot;
+        if (site->bank == 0) {
+            site->bank = bank, site->addr = addr, site->count = 1;
+            return;
+        }
+        if ((site->bank == bank) && (site->addr == addr)) {
+            vm_profile_inc(&site->count);
+            return;
+        }
+    }
+    vm_profile_inc(&rec->dropped);
+}
+
+void vm_profile_step(SCRIPT_CTX * ctx) BANKED {
+    if (ctx->terminated) return;
+    // opcode, then the bank and pointer operands of vm_call_native
+    struct {
+        UBYTE op;
+        UBYTE bank;
+        UWORD ptr;
+    } ins;
+    MemcpyBanked(&ins, ctx->PC, sizeof(ins), ctx->bank);
+
+    SWITCH_RAM_BANK(VM_PROFILER_SRAM_BANK, RAM_BANKS_ONLY);
+    vm_profile_record_t * rec = VM_PROFILE_SRAM->records + VM_PROFILE_SRAM->head;
+    vm_profile_inc(&rec->steps);
+    vm_profile_inc(&rec->opcodes[(ins.op < VM_PROFILE_OPCODES) ? ins.op : (VM_PROFILE_OPCODES - 1)]);
+    vm_profile_inc(&rec->contexts[ctx->ID - 1]);
+    vm_profile_count_site(rec, rec->regions, VM_PROFILE_REGIONS - 1, ctx->bank, (UWORD)ctx->PC & ~((1 << VM_PROFILE_REGION_SHIFT) - 1));
+    if (ins.op == VM_PROFILE_OP_CALL_NATIVE) {
+        vm_profile_count_site(rec, rec->natives, VM_PROFILE_NATIVES - 1, ins.bank, ins.ptr);
+    }
+    SWITCH_RAM_BANK(0, RAM_BANKS_ONLY);
+}
+
+void vm_profile_frame_end(void) BANKED {
+    SWITCH_RAM_BANK(VM_PROFILER_SRAM_BANK, RAM_BANKS_ONLY);
+    VM_PROFILE_SRAM->records[VM_PROFILE_SRAM->head].frames++;
+    if (++vm_profile_frames == VM_PROFILE_PERIOD) {
+        vm_profile_frames = 0;
+        UBYTE head = (VM_PROFILE_SRAM->head + 1) & (VM_PROFILE_RECORDS - 1);
+        memset(VM_PROFILE_SRAM->records + head, 0, sizeof(vm_profile_record_t));
+        VM_PROFILE_SRAM->head = head;
+        VM_PROFILE_SRAM->sequence++;
+    }
+    SWITCH_RAM_BANK(0, RAM_BANKS_ONLY);
+}
+
+#endif
+
+void vm_profile_init(void) BANKED {
+#if VM_PROFILER
+    vm_profile_frames = 0;
+    ENABLE_RAM_MBC5;
+    SWITCH_RAM_BANK(VM_PROFILER_SRAM_BANK, RAM_BANKS_ONLY);
+    memset(VM_PROFILE_SRAM, 0, sizeof(vm_profile_sram_t));
+    memcpy(VM_PROFILE_SRAM->magic, VM_PROFILE_MAGIC, sizeof(VM_PROFILE_SRAM->magic));
+    VM_PROFILE_SRAM->record_size = sizeof(vm_profile_record_t);
+    VM_PROFILE_SRAM->record_count = VM_PROFILE_RECORDS;
+    SWITCH_RAM_BANK(0, RAM_BANKS_ONLY);
+#endif
+}
@@ -0,0 +1,108 @@
+export const id = "EVENT_CALL_NATIVE_BATCH";
+export const name = "Call Native Functions (Batched)";
+export const groups = ["EngineCorePlugin"];
+
+const MAX_CALLS = 4;
+const MAX_ARGS = 3;
+
+export const autoLabel = (fetchArg) => {
+  const names = [];
+  for (let c = 1; c <= Math.min(fetchArg("calls"), MAX_CALLS); c++) names.push(fetchArg(`fn${c}`));
+  return `Call natives ${names.join(", ")}`;
+};
+
+const callFields = (c) => {
+  const shown = c === 1 ? [] : [{ key: "calls", gte: c }];
+  const fields = [
+    {
+      key: `fn${c}`,
+      label: `Native ${c}`,
+      description: "Name of the native routine, e.g. vm_paint",
+      type: "text",
+      defaultValue: "",
+      width: "50%",
+      conditions: shown,
+    },
+    {
+      key: `argc${c}`,
+      label: "Arguments",
+      type: "number",
+      min: 0,
+      max: MAX_ARGS,
+      defaultValue: 0,
+      width: "50%",
+      conditions: shown,
+    },
+  ];
+  for (let a = 0; a < MAX_ARGS; a++) {
+    fields.push({
+      key: `arg${c}_${a}`,
+      label: `FN_ARG${a}`,
+      type: "union",
+      types: ["number", "variable"],
+      defaultType: "number",
+      defaultValue: {
+        number: 0,
+        variable: "LAST_VARIABLE",
+      },
+      conditions: [...shown, { key: `argc${c}`, gt: a }],
+    });
+  }
+  return fields;
+};
+
+export const fields = [
+  {
+    key: "calls",
+    label: "Calls",
+    description: "Natives run one after another in a single VM instruction",
+    type: "number",
+    min: 1,
+    max: MAX_CALLS,
+    defaultValue: 1,
+  },
+  ...[1, 2, 3, 4].flatMap(callFields),
+];
+
+// One VM_CALL_NATIVE to vm_call_native_batch followed by its descriptor
+// list (see native_batch.h). Constants become immediates and variables are
+// read when the batch runs, so nothing is pushed or popped by the script.
+// Arguments reach the native by value: natives that write results back
+// through FN_ARGn must not be called from here.
+const callNativeBatch = (helpers, calls) => {
+  const { _callNative, _addCmd, getVariableAlias } = helpers;
+  _callNative("vm_call_native_batch");
+  _addCmd(".db", calls.length);
+  for (const call of calls) {
+    let mask = 0;
+    const bytes = [];
+    call.args.forEach((arg, i) => {
+      if (arg.type === "variable") {
+        const alias = getVariableAlias(arg.value);
+        mask |= 1 << i;
+        bytes.push(`#<${alias}`, `#>${alias}`);
+      } else {
+        const value = Number(arg.value) & 0xffff;
+        bytes.push(value & 0xff, value >> 8);
+      }
+    });
+    _addCmd(".db", `#<b_${call.fn}`, `#<_${call.fn}`, `#>_${call.fn}`, call.args.length, mask);
+    if (bytes.length) _addCmd(".db", ...bytes);
+  }
+};
+
+export const compile = (input, helpers) => {
+  const { _addComment } = helpers;
+  const calls = [];
+  for (let c = 1; c <= Math.min(input.calls, MAX_CALLS); c++) {
+    const fn = String(input[`fn${c}`] || "").trim();
+    if (!fn) continue;
+    const args = [];
+    for (let a = 0; a < Math.min(input[`argc${c}`] || 0, MAX_ARGS); a++) args.push(input[`arg${c}_${a}`]);
+    calls.push({ fn, args });
+  }
+  if (!calls.length) return;
+
+  _addComment(`Batched natives: ${calls.map((c) => c.fn).join(", ")}`);
+  callNativeBatch(helpers, calls);
+};
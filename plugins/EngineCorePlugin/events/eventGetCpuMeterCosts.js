@@ -0,0 +1,57 @@
+export const id = "EVENT_GET_CPU_METER_COSTS";
+export const name = "Get CPU Meter Frame Costs";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Get CPU meter frame costs`;
+};
+
+export const fields = [
+  {
+    key: "stage",
+    label: "Stage",
+    type: "select",
+    options: [
+      [0, "VM"],
+      [1, "Scroll"],
+      [2, "Actors"],
+      [3, "Projectiles"],
+      [4, "Level Code"],
+      [5, "Total"],
+    ],
+    defaultValue: 5,
+  },
+  {
+    key: "count",
+    label: "Frames",
+    description: "Number of frames to read, newest first (max 8)",
+    type: "number",
+    min: 1,
+    max: 8,
+    defaultValue: 1,
+  },
+  {
+    key: "variable",
+    label: "Store Costs Starting At",
+    description:
+      "Scanline cost of each frame is stored in this variable and the ones that follow it",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment, getVariableAlias } =
+    helpers;
+
+  const variableAlias = getVariableAlias(input.variable);
+
+  _addComment("Get CPU meter frame costs");
+
+  _stackPushConst(variableAlias);
+  _stackPushConst(input.count);
+  _stackPushConst(input.stage);
+
+  _callNative("vm_cpu_meter_get_costs");
+  _stackPop(3);
+};
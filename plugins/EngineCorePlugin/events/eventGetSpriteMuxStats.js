@@ -0,0 +1,32 @@
+export const id = "EVENT_GET_SPRITE_MUX_STATS";
+export const name = "Get Sprite Multiplexer Stats";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Get sprite multiplexer stats`;
+};
+
+export const fields = [
+  {
+    key: "variable",
+    label: "Store Stats Starting At",
+    description:
+      "Stores actors left out last frame, sprites on the busiest scanline last frame and overloaded frames since boot in this variable and the two that follow it",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment, getVariableAlias } =
+    helpers;
+
+  const variableAlias = getVariableAlias(input.variable);
+
+  _addComment("Get sprite multiplexer stats");
+
+  _stackPushConst(variableAlias);
+
+  _callNative("vm_sprite_mux_get_stats");
+  _stackPop(1);
+};
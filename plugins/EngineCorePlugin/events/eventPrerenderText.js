@@ -0,0 +1,33 @@
+export const id = "EVENT_PRERENDER_TEXT";
+export const name = "Pre-render Text";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Pre-render text`;
+};
+
+export const fields = [
+  {
+    key: "text",
+    label: "Text",
+    type: "textarea",
+    placeholder: "Level Code",
+    defaultValue: "",
+  },
+  {
+    key: "description",
+    type: "label",
+    defaultValue:
+      "Renders the text into the glyph cache without showing it, so menus and labels using the same text draw as a tile copy the first time. Use at scene init, not while a dialogue is open. Only text drawn at instant speed uses the cache.",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _loadStructuredText, _addComment } = helpers;
+
+  _addComment("Pre-render text");
+
+  _loadStructuredText(input.text || "");
+
+  _callNative("vm_ui_text_cache_prerender");
+};
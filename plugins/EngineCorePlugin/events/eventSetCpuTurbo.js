@@ -0,0 +1,33 @@
+export const id = "EVENT_SET_CPU_TURBO";
+export const name = "Set CGB Turbo";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return fetchArg("turbo") ? `Hold CGB turbo` : `Release CGB turbo`;
+};
+
+export const fields = [
+  {
+    key: "turbo",
+    label: "Hold double speed",
+    type: "checkbox",
+    defaultValue: true,
+  },
+  {
+    key: "description",
+    type: "label",
+    defaultValue:
+      "With CGB Double Speed set to Turbo Sections Only, keeps the CPU in double speed until released or the scene changes. Has no effect on DMG or when double speed is always on.",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment } = helpers;
+
+  _addComment(input.turbo ? "Hold CGB turbo" : "Release CGB turbo");
+
+  _stackPushConst(input.turbo ? 1 : 0);
+
+  _callNative("vm_cpu_turbo_hold");
+  _stackPop(1);
+};
@@ -0,0 +1,27 @@
+export const id = "EVENT_SHOW_CPU_METER_BAR";
+export const name = "Show CPU Meter Bar";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Show CPU meter bar`;
+};
+
+export const fields = [
+  {
+    key: "enabled",
+    label: "Show bar on window layer",
+    type: "checkbox",
+    defaultValue: true,
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment } = helpers;
+
+  _addComment("Show CPU meter bar");
+
+  _stackPushConst(input.enabled ? 1 : 0);
+
+  _callNative("vm_cpu_meter_show_bar");
+  _stackPop(1);
+};
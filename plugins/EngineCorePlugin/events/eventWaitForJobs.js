@@ -0,0 +1,28 @@
+export const id = "EVENT_WAIT_FOR_JOBS";
+export const name = "Wait For Background Jobs";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Wait for background jobs`;
+};
+
+export const fields = [
+  {
+    key: "description",
+    type: "label",
+    defaultValue:
+      "Waits until every frame-sliced job (for example a level rebuild started without waiting) has finished.",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment } = helpers;
+
+  _addComment("Wait for background jobs");
+
+  // JOB_ALL
+  _stackPushConst(0xfe);
+
+  _callNative("vm_job_wait");
+  _stackPop(1);
+};
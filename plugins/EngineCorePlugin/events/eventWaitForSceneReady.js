@@ -0,0 +1,24 @@
+export const id = "EVENT_WAIT_FOR_SCENE_READY";
+export const name = "Wait For Scene Ready";
+export const groups = ["EngineCorePlugin"];
+
+export const autoLabel = (fetchArg) => {
+  return `Wait for scene ready`;
+};
+
+export const fields = [
+  {
+    key: "description",
+    type: "label",
+    defaultValue:
+      "Waits until every sprite of the current scene has been uploaded. Actors and projectiles upload their own sprite when they appear, so this is only needed before effects that depend on all of them, such as a fade in that must not show a partly loaded scene.",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _addComment } = helpers;
+
+  _addComment("Wait for scene ready");
+
+  _callNative("vm_scene_wait_ready");
+};
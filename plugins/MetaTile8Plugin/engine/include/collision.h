@@ -22,6 +22,16 @@
 #define SRAM_MAP_DATA_PTR (0xA000 + (0x2000 - MAX_MAP_DATA_SIZE))
 #define SRAM_COLLISION_DATA_PTR (SRAM_MAP_DATA_PTR - 0x0100)
 
+// Resolved collision values are cached in WRAM as 16 tile row segments, so
+// sweeps over neighbouring tiles skip the map lookup and the bank switch.
+// Segment parity is part of the slot so a box straddling two segments
+// keeps both cached, and consecutive rows land in different slots.
+#define COLLISION_ROW_SLOTS 8
+#define COLLISION_ROW_SPAN_SHIFT 4
+#define COLLISION_ROW_SPAN (1 << COLLISION_ROW_SPAN_SHIFT)
+#define COLLISION_ROW_NONE 0xFF
+#define COLLISION_ROW_SLOT(seg, ty) ((((ty) << 1) | ((seg) & 1)) & (COLLISION_ROW_SLOTS - 1))
+
 typedef struct bounding_box_t {
     BYTE left, right, top, bottom;
 } bounding_box_t;
@@ -38,6 +48,16 @@ extern UBYTE metatile_bank;
 
 extern UBYTE image_tile_width_bit;
 
+extern UBYTE collision_row_y[COLLISION_ROW_SLOTS];
+extern UBYTE collision_row_seg[COLLISION_ROW_SLOTS];
+extern UBYTE collision_row_data[COLLISION_ROW_SLOTS * COLLISION_ROW_SPAN];
+
+// Fill a cache slot with the collision values of one row segment
+void collision_row_load(UBYTE slot, UBYTE seg, UBYTE ty) BANKED;
+
+// Drop every cached row segment; call when the map or collision table changes
+void collision_rows_reset(void) BANKED;
+
 /**
  * Check if point is within positioned bounding box.
  *
@@ -80,11 +100,12 @@ inline UBYTE bb_intersects(bounding_box_t *bb_a, point16_t *offset_a, bounding_b
  */
 inline UBYTE tile_at(UBYTE tx, UBYTE ty) {
 	if ((tx < image_tile_width) && (ty < image_tile_height)) {
-		if (metatile_bank) {
-			return sram_collision_data[sram_map_data[METATILE_MAP_OFFSET(tx, ty)]];
-		} else {
-			return ReadBankedUBYTE(collision_ptr + (ty * (UINT16)image_tile_width) + tx, collision_bank);
+		UBYTE seg = tx >> COLLISION_ROW_SPAN_SHIFT;
+		UBYTE slot = COLLISION_ROW_SLOT(seg, ty);
+		if ((collision_row_y[slot] != ty) || (collision_row_seg[slot] != seg)) {
+			collision_row_load(slot, seg, ty);
 		}
+		return collision_row_data[(slot << COLLISION_ROW_SPAN_SHIFT) | (tx & (COLLISION_ROW_SPAN - 1))];
 	}
     return COLLISION_ALL;
 }
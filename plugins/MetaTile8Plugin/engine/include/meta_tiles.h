@@ -23,7 +23,48 @@ extern unsigned char *metatile_attr_ptr;
 
 extern UBYTE image_tile_width_bit;
 
-void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_id, UBYTE commit) BANKED;
+// While set, committed tiles only go to sram_map_data; meta_tile_deferred records
+// that the screen is out of date
+extern UBYTE meta_tile_defer;
+extern UBYTE meta_tile_deferred;
+
+// Packed metatile map written by the Load meta tiles event. Every row is coded
+// on its own and indexed, so any row can be unpacked without the ones above it.
+// A token below META_MAP_RUN is followed by token + 1 literal bytes, a token
+// from META_MAP_RUN up by one byte repeated (token & 0x7F) + 1 times
+#define META_MAP_RUN 0x80
+
+typedef struct meta_map_t
+{
+	UBYTE width;
+	UBYTE height;
+	const UWORD *rows; // offset of each row in data; identical rows share one
+	const UBYTE *data;
+} meta_map_t;
+
+/**
+ * Unpack part of a row of a packed map.
+ *
+ * @param bank Bank of the map
+ * @param map Map header, already copied out of its bank
+ * @param y Row to unpack
+ * @param skip Tiles to skip at the start of the row
+ * @param count Tiles to write
+ * @param dest Destination, usually a row of sram_map_data
+ */
+void meta_map_unpack_row(UBYTE bank, const meta_map_t *map, UBYTE y, UBYTE skip, UBYTE count, UBYTE *dest) BANKED;
+
+/**
+ * Hold back the VRAM writes of committed tiles during a bulk rewrite. Ending
+ * the hold redraws the screen once if any tile was held back, through HDMA
+ * whole rows on CGB.
+ *
+ * @param defer TRUE to start holding, FALSE to end
+ */
+void meta_tiles_defer_commit(UBYTE defer) BANKED;
+
+// Called per tile by the editor plugins, so it lives in the home bank
+void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_id, UBYTE commit) NONBANKED;
 
 
 #endif
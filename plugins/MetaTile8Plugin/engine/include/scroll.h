@@ -55,6 +55,8 @@ void scroll_update(void) BANKED;
 void scroll_repaint(void) BANKED;
 
 void scroll_render_rows(INT16 scroll_x, INT16 scroll_y, BYTE row_offset, BYTE n_rows) BANKED;
+// Redraw the visible map from sram_map_data without activating actors
+void scroll_redraw(void) BANKED;
 UBYTE scroll_viewport(parallax_row_t * port) BANKED;
 void scroll_queue_row(UBYTE x, UBYTE y) BANKED;
 void scroll_queue_col(UBYTE x, UBYTE y) BANKED;
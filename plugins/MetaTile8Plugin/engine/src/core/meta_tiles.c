@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "meta_tiles.h"
+#include "collision.h"
 #include "system.h"
 #include "vm.h"
 #include "bankdata.h"
@@ -13,6 +14,7 @@
 #include "data_manager.h"
 #include "data/states_defines.h"
 #include "tile_utils.h"
+#include "scene_header.h"
 
 // Character tile range constants for cycling (in case tile_utils.h is not found)
 #ifndef TILE_CHAR_FIRST
@@ -31,21 +33,92 @@ unsigned char *metatile_attr_ptr;
 
 UBYTE image_tile_width_bit;
 
+UBYTE meta_tile_defer;
+UBYTE meta_tile_deferred;
+
+UBYTE collision_row_y[COLLISION_ROW_SLOTS];
+UBYTE collision_row_seg[COLLISION_ROW_SLOTS];
+UBYTE collision_row_data[COLLISION_ROW_SLOTS * COLLISION_ROW_SPAN];
+
+void collision_rows_reset(void) BANKED
+{
+	memset(collision_row_y, COLLISION_ROW_NONE, sizeof(collision_row_y));
+}
+
+void collision_row_load(UBYTE slot, UBYTE seg, UBYTE ty) BANKED
+{
+	UBYTE x = seg << COLLISION_ROW_SPAN_SHIFT;
+	UBYTE len = image_tile_width - x;
+	if (len > COLLISION_ROW_SPAN)
+	{
+		len = COLLISION_ROW_SPAN;
+	}
+	UBYTE *dest = collision_row_data + (slot << COLLISION_ROW_SPAN_SHIFT);
+	if (metatile_bank)
+	{
+		const UBYTE *src = sram_map_data + METATILE_MAP_OFFSET(x, ty);
+		for (UBYTE i = len; i != 0; i--)
+		{
+			*dest++ = sram_collision_data[*src++];
+		}
+	}
+	else
+	{
+		MemcpyBanked(dest, collision_ptr + (ty * (UINT16)image_tile_width) + x, len, collision_bank);
+	}
+	collision_row_y[slot] = ty;
+	collision_row_seg[slot] = seg;
+}
+
+void meta_map_unpack_row(UBYTE bank, const meta_map_t *map, UBYTE y, UBYTE skip, UBYTE count, UBYTE *dest) BANKED
+{
+	const UBYTE *src = map->data + ReadBankedUWORD((const unsigned char *)(map->rows + y), bank);
+	while (count)
+	{
+		UBYTE token = ReadBankedUBYTE(src++, bank);
+		UBYTE len = (token & (META_MAP_RUN - 1)) + 1;
+		UBYTE coded = (token & META_MAP_RUN) ? 1 : len;
+		if (skip >= len)
+		{
+			skip -= len;
+			src += coded;
+			continue;
+		}
+		len -= skip;
+		if (len > count)
+		{
+			len = count;
+		}
+		if (token & META_MAP_RUN)
+		{
+			memset(dest, ReadBankedUBYTE(src, bank), len);
+		}
+		else
+		{
+			MemcpyBanked(dest, src + skip, len, bank);
+		}
+		src += coded;
+		skip = 0;
+		dest += len;
+		count -= len;
+	}
+}
+
 void vm_load_meta_tiles(SCRIPT_CTX *THIS) OLDCALL BANKED
 {
 	scroll_reset();
 	uint8_t scene_bank = *(uint8_t *)VM_REF_TO_PTR(FN_ARG0);
 	const scene_t *scene_ptr = *(scene_t **)VM_REF_TO_PTR(FN_ARG1);
-	scene_t scn;
-	MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-	MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-	metatile_bank = bkg.tilemap.bank;
-	metatile_ptr = bkg.tilemap.ptr;
-	metatile_attr_bank = bkg.cgb_tilemap_attr.bank;
-	metatile_attr_ptr = bkg.cgb_tilemap_attr.ptr;
+	// packed copy of the scene's map, bank 0 if the scene keeps its plain tilemap
+	uint8_t map_bank = *(uint8_t *)VM_REF_TO_PTR(FN_ARG2);
+	const meta_map_t *map_ptr = *(meta_map_t **)VM_REF_TO_PTR(FN_ARG3);
+	const scene_header_t *header = scene_header_get(scene_bank, scene_ptr);
+	metatile_bank = header->background.tilemap.bank;
+	metatile_ptr = header->background.tilemap.ptr;
+	metatile_attr_bank = header->background.cgb_tilemap_attr.bank;
+	metatile_attr_ptr = header->background.cgb_tilemap_attr.ptr;
 
-	MemcpyBanked(&sram_collision_data, scn.collisions.ptr, 256, scn.collisions.bank);
+	MemcpyBanked(&sram_collision_data, header->collisions.ptr, 256, header->collisions.bank);
 
 	image_tile_width_bit = 1;
 	UBYTE width = (image_tile_width - 1);
@@ -54,10 +127,23 @@ void vm_load_meta_tiles(SCRIPT_CTX *THIS) OLDCALL BANKED
 		image_tile_width_bit++;
 	}
 
-	for (UBYTE y = 0; y < image_tile_height; y++)
+	if (map_bank)
 	{
-		MemcpyBanked(sram_map_data + METATILE_MAP_OFFSET(0, y), image_ptr + (UWORD)(y * image_tile_width), image_tile_width, image_bank);
+		meta_map_t map;
+		MemcpyBanked(&map, map_ptr, sizeof(map), map_bank);
+		for (UBYTE y = 0; y < image_tile_height; y++)
+		{
+			meta_map_unpack_row(map_bank, &map, y, 0, image_tile_width, sram_map_data + METATILE_MAP_OFFSET(0, y));
+		}
 	}
+	else
+	{
+		for (UBYTE y = 0; y < image_tile_height; y++)
+		{
+			MemcpyBanked(sram_map_data + METATILE_MAP_OFFSET(0, y), image_ptr + (UWORD)(y * image_tile_width), image_tile_width, image_bank);
+		}
+	}
+	collision_rows_reset();
 
 	scroll_update();
 }
@@ -83,6 +169,7 @@ void vm_replace_collision(SCRIPT_CTX *THIS) OLDCALL BANKED
 	uint8_t tile_id = *(uint8_t *)VM_REF_TO_PTR(FN_ARG0);
 	uint8_t collision = *(uint8_t *)VM_REF_TO_PTR(FN_ARG1);
 	sram_collision_data[tile_id] = collision;
+	collision_rows_reset();
 }
 
 void vm_submap_metatiles(SCRIPT_CTX *THIS) OLDCALL BANKED
@@ -93,6 +180,8 @@ void vm_submap_metatiles(SCRIPT_CTX *THIS) OLDCALL BANKED
 	uint8_t commit = *(int8_t *)VM_REF_TO_PTR(FN_ARG3);
 	uint8_t scene_bank = *(uint8_t *)VM_REF_TO_PTR(FN_ARG4);
 	const scene_t *scene_ptr = *(scene_t **)VM_REF_TO_PTR(FN_ARG5);
+	uint8_t map_bank = *(uint8_t *)VM_REF_TO_PTR(FN_ARG6);
+	const meta_map_t *map_ptr = *(meta_map_t **)VM_REF_TO_PTR(FN_ARG7);
 
 	uint8_t source_x = source_pos & 0xFF;
 	uint8_t source_y = (source_pos >> 8) & 0xFF;
@@ -101,18 +190,29 @@ void vm_submap_metatiles(SCRIPT_CTX *THIS) OLDCALL BANKED
 	uint8_t width = (wh & 0xFF) & 31;
 	uint8_t height = ((wh >> 8) & 0xFF) & 31;
 
-	scene_t scn;
-	MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-	MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-	unsigned char *tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char *tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;
+	const background_t *bkg = &scene_header_get(scene_bank, scene_ptr)->background;
+	unsigned char *tilemap_ptr = bkg->tilemap.ptr;
+
+	meta_map_t map;
+	if (map_bank)
+	{
+		MemcpyBanked(&map, map_ptr, sizeof(map), map_bank);
+	}
 
 	UBYTE buffer_size = sizeof(UBYTE) * width;
+	collision_rows_reset();
 	for (uint8_t i = 0; i < height; i++)
 	{
 		UBYTE current_y = (dest_y + i);
-		MemcpyBanked(sram_map_data + METATILE_MAP_OFFSET(dest_x, current_y), tilemap_ptr + (UWORD)(((source_y + i) * bkg.width) + source_x), width, bkg.tilemap.bank);
+		if (map_bank)
+		{
+			// the row index lets this start at the source row and column
+			meta_map_unpack_row(map_bank, &map, source_y + i, source_x, width, sram_map_data + METATILE_MAP_OFFSET(dest_x, current_y));
+		}
+		else
+		{
+			MemcpyBanked(sram_map_data + METATILE_MAP_OFFSET(dest_x, current_y), tilemap_ptr + (UWORD)(((source_y + i) * bkg->width) + source_x), width, bkg->tilemap.bank);
+		}
 		if (commit)
 		{
 			for (UBYTE j = 0; j < width; j++)
@@ -137,11 +237,33 @@ void vm_submap_metatiles(SCRIPT_CTX *THIS) OLDCALL BANKED
 	}
 }
 
-void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_id, UBYTE commit) BANKED
+void meta_tiles_defer_commit(UBYTE defer) BANKED
+{
+	meta_tile_defer = defer;
+	if (!defer && meta_tile_deferred)
+	{
+		meta_tile_deferred = FALSE;
+		scroll_redraw();
+	}
+}
+
+void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_id, UBYTE commit) NONBANKED
 {
 	sram_map_data[METATILE_MAP_OFFSET(x, y)] = tile_id;
+	// patch the cached segment in place so painting doesn't force a reload
+	UBYTE seg = x >> COLLISION_ROW_SPAN_SHIFT;
+	UBYTE slot = COLLISION_ROW_SLOT(seg, y);
+	if (metatile_bank && (collision_row_y[slot] == y) && (collision_row_seg[slot] == seg))
+	{
+		collision_row_data[(slot << COLLISION_ROW_SPAN_SHIFT) | (x & (COLLISION_ROW_SPAN - 1))] = sram_collision_data[tile_id];
+	}
 	if (commit)
 	{
+		if (meta_tile_defer)
+		{
+			meta_tile_deferred = TRUE;
+			return;
+		}
 #ifdef CGB
 		if (_is_CGB)
 		{
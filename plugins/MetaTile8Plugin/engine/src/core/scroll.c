@@ -14,6 +14,8 @@
 #include "parallax.h"
 #include "palette.h"
 #include "meta_tiles.h"
+#include "collision.h"
+#include "hdma.h"
 
 // put submap of a large map to screen
 void set_bkg_submap(UINT8 x, UINT8 y, UINT8 w, UINT8 h, const unsigned char *map, UINT8 map_w) OLDCALL;
@@ -52,6 +54,9 @@ void scroll_reset(void) BANKED {
 	scroll_y = 0x7FFF;
 	metatile_bank = 0;
 	metatile_attr_bank = 0;
+	meta_tile_defer = FALSE;
+	meta_tile_deferred = FALSE;
+	collision_rows_reset();
 }
 
 void scroll_update(void) BANKED {
@@ -174,6 +179,42 @@ void scroll_repaint(void) BANKED {
     scroll_update();
 }
 
+#ifdef CGB
+// Whole 32 tile map rows through H-Blank DMA: all tile rows first, then all attribute
+// rows, so VBK_REG flips once and each row is built while the previous one goes out
+static void scroll_draw_rows_hdma(UBYTE x, UBYTE y, BYTE n_rows) {
+    for (UBYTE attr = 0; attr != 2; attr++) {
+        unsigned char *lut = (attr) ? metatile_attr_ptr : metatile_ptr;
+        UBYTE lut_bank = (attr) ? metatile_attr_bank : metatile_bank;
+        VBK_REG = attr;
+        UBYTE ty = y;
+        for (BYTE i = 0; i != n_rows && ty != image_tile_height; ++i, ty++) {
+            UBYTE *row = hdma_row_begin();
+            for (UWORD mx = x; mx != (UWORD)x + HDMA_ROW_SIZE; mx++) {
+                // past the right edge the ring holds the columns one ring width to the left
+                UBYTE tx = (mx >= image_tile_width) ? (UBYTE)(mx - HDMA_ROW_SIZE) : (UBYTE)mx;
+                row[tx & 31] = ReadBankedUBYTE(lut + sram_map_data[METATILE_MAP_OFFSET(tx, ty)], lut_bank);
+            }
+            hdma_row_commit(ty);
+        }
+        hdma_wait();
+    }
+    VBK_REG = 0;
+}
+#endif
+
+static void scroll_draw_rows(UBYTE x, UBYTE y, BYTE n_rows) {
+#ifdef CGB
+    if (_is_CGB && metatile_bank && metatile_attr_bank && (image_tile_width >= HDMA_ROW_SIZE)) {
+        scroll_draw_rows_hdma(x, y, n_rows);
+        return;
+    }
+#endif
+    for (BYTE i = 0; i != n_rows && y != image_tile_height; ++i, y++) {
+        scroll_load_row(x, y);
+    }
+}
+
 void scroll_render_rows(INT16 scroll_x, INT16 scroll_y, BYTE row_offset, BYTE n_rows) BANKED {
     // Clear pending rows/ columns
     pending_w_i = 0;
@@ -182,12 +223,19 @@ void scroll_render_rows(INT16 scroll_x, INT16 scroll_y, BYTE row_offset, BYTE n_
     UBYTE x = MAX(0, (scroll_x >> 3) - SCREEN_PAD_LEFT);
     UBYTE y = MAX(0, (scroll_y >> 3) + row_offset);
 
+    scroll_draw_rows(x, y, n_rows);
     for (BYTE i = 0; i != n_rows && y != image_tile_height; ++i, y++) {
-        scroll_load_row(x, y);
         activate_actors_in_row(x, y);
     }	
 }
 
+void scroll_redraw(void) BANKED {
+    // the rows a full repaint would draw, leaving actors and pending rows alone
+    UBYTE x = MAX(0, (draw_scroll_x >> 3) - SCREEN_PAD_LEFT);
+    UBYTE y = MAX(0, (draw_scroll_y >> 3) - SCREEN_PAD_TOP);
+    scroll_draw_rows(x, y, SCREEN_TILE_REFRES_H);
+}
+
 void scroll_queue_row(UBYTE x, UBYTE y) BANKED {
     
     // Don't queue rows past image height
@@ -26,10 +26,90 @@ export const fields = [
     type: "checkbox",
     defaultValue: false,
   },
+  {
+    key: "packMap",
+    label: "Pack map (Submap metatiles from this scene must use Packed source)",
+    type: "checkbox",
+    defaultValue: false,
+  },
 ];
 
+// Converted map per background: { data, packed, unpacked }. Scenes sharing
+// a background share its tilemap, so the packed and unpacked uses are tracked
+// together rather than keyed apart.
 const background_cache = {};
 
+// Must match META_MAP_RUN in meta_tiles.h
+const META_MAP_RUN = 0x80;
+const META_MAP_RUN_MAX = 128;
+
+const metaMapSymbol = (scene) => `${scene.background.symbol || scene.symbol}_meta_map`;
+
+// Runs of 3 or more become one token and the byte, everything else literal tokens of up to 128 bytes
+const packRow = (row) => {
+  const out = [];
+  let literal = [];
+  const flush = () => {
+    while (literal.length) {
+      const chunk = literal.splice(0, META_MAP_RUN_MAX);
+      out.push(chunk.length - 1, ...chunk);
+    }
+  };
+  for (let x = 0; x < row.length; ) {
+    let run = 1;
+    while (x + run < row.length && run < META_MAP_RUN_MAX && row[x + run] === row[x]) run++;
+    if (run >= 3) {
+      flush();
+      out.push(META_MAP_RUN | (run - 1), row[x]);
+      x += run;
+    } else {
+      literal.push(row[x++]);
+    }
+  }
+  flush();
+  return out;
+};
+
+const packMetaMap = (symbol, data, width, height) => {
+  const bytes = [];
+  const rows = [];
+  const seen = {};
+  for (let y = 0; y < height; y++) {
+    const packed = packRow(data.slice(y * width, (y + 1) * width));
+    const key = packed.join(",");
+    if (seen[key] === undefined) {
+      seen[key] = bytes.length;
+      bytes.push(...packed);
+    }
+    rows.push(seen[key]);
+  }
+  const lines = (values) => {
+    const out = [];
+    for (let i = 0; i < values.length; i += 16) out.push(`    ${values.slice(i, i + 16).join(", ")}`);
+    return out.join(",\n");
+  };
+  return `#pragma bank 255
+
+// Packed metatile map: ${width}x${height} tiles, ${bytes.length} bytes
+
+#include "meta_tiles.h"
+
+BANKREF(${symbol})
+
+static const UWORD ${symbol}_rows[] = {
+${lines(rows)}
+};
+
+static const UBYTE ${symbol}_data[] = {
+${lines(bytes)}
+};
+
+const meta_map_t ${symbol} = {
+    ${width}, ${height}, ${symbol}_rows, ${symbol}_data
+};
+`;
+};
+
 export const compile = (input, helpers) => {
   const { options, _callNative, _stackPushConst, _stackPush, _stackPop, _addComment, _declareLocal, variableSetToScriptValue, writeAsset } = helpers;
   
@@ -38,7 +118,8 @@ export const compile = (input, helpers) => {
   if (!metatile_scene) {
     return;
   }
-  if (!background_cache[scene.backgroundId]){
+  let cached = background_cache[scene.backgroundId];
+  if (!cached){
 	const newTilemapData = [];
 	const oldTilemapData = scene.background.tilemap.data;
 	const oldTilemapAttrData = scene.background.tilemapAttr?.data;
@@ -71,18 +152,33 @@ export const compile = (input, helpers) => {
 			tile_found = false;
 		}
 	}
-	scene.background.tilemap.data = newTilemapData; 
 	scene.background.tilemapAttr.data = [0]; 
 	scene.collisions = [0];
-	background_cache[scene.backgroundId] = true;
+	cached = background_cache[scene.backgroundId] = { data: newTilemapData, packed: false, unpacked: false };
   }
+  if (input.packMap && !cached.packed) {
+	writeAsset(`${metaMapSymbol(scene)}.c`, packMetaMap(metaMapSymbol(scene), cached.data, scene.background.width, scene.background.height));
+	cached.packed = true;
+  }
+  if (!input.packMap) {
+	cached.unpacked = true;
+  }
+  // the packed copy replaces the tilemap, unless any scene loads this background unpacked
+  scene.background.tilemap.data = cached.unpacked ? cached.data : [0];
     
   _addComment("Load meta tiles");
   
+  if (input.packMap) {
+    _stackPushConst(`_${metaMapSymbol(scene)}`);
+    _stackPushConst(`___bank_${metaMapSymbol(scene)}`);
+  } else {
+    _stackPushConst(0);
+    _stackPushConst(0);
+  }
   _stackPushConst(`_${metatile_scene.symbol}`);
   _stackPushConst(`___bank_${metatile_scene.symbol}`);
   		
   _callNative("vm_load_meta_tiles");
-  _stackPop(2);  
+  _stackPop(4);  
   
 };
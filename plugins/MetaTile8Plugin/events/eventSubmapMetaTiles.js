@@ -82,6 +82,12 @@ export const fields = [
     type: "checkbox",
     defaultValue: false,
   },
+  {
+    key: "packedSource",
+    label: "Packed source (the scene's Load meta tiles packs its map)",
+    type: "checkbox",
+    defaultValue: false,
+  },
 ];
 
 export const compile = (input, helpers) => {
@@ -135,6 +141,15 @@ export const compile = (input, helpers) => {
     
   
   
+  if (input.packedSource) {
+    // written by Load meta tiles, see metaMapSymbol there
+    const metaMapSymbol = `${scene.background.symbol || scene.symbol}_meta_map`;
+    _stackPushConst(`_${metaMapSymbol}`);
+    _stackPushConst(`___bank_${metaMapSymbol}`);
+  } else {
+    _stackPushConst(0);
+    _stackPushConst(0);
+  }
   _stackPushConst(`_${scene.symbol}`);
   _stackPushConst(`___bank_${scene.symbol}`); 
   _stackPushConst((input.commit)? 1: 0);  
@@ -143,6 +158,6 @@ export const compile = (input, helpers) => {
   _stackPush(tmp0);
   		
   _callNative("vm_submap_metatiles");
-  _stackPop(6);  
+  _stackPop(8);  
   
 };
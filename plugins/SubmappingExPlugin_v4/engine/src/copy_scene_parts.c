@@ -1,14 +1,172 @@
 #pragma bank 255
 
 #include <gbdk/platform.h>
+#include <string.h>
 #include "system.h"
 #include "vm.h"
 #include "gbs_types.h"
 #include "scroll.h"
 #include "bankdata.h"
 #include "data_manager.h"
+#include "scene_header.h"
+#include "job.h"
+#include "data/states_defines.h"
 
-UBYTE tmp_tile_buffer[32];
+BANKREF(COPY_SCENE_PARTS)
+
+// Rows a queued copy writes to VRAM each frame
+#ifndef SUBMAP_ROWS_PER_FRAME
+#define SUBMAP_ROWS_PER_FRAME 4
+#endif
+// Rows staged ahead of VRAM; a power of two, at least SUBMAP_ROWS_PER_FRAME
+#define SUBMAP_RING_ROWS 8
+#define SUBMAP_QUEUE_SIZE 4
+#define SUBMAP_TARGET_BKG 0
+#define SUBMAP_TARGET_WIN 1
+// Handle that waits for every queued copy
+#define SUBMAP_COPY_ALL 0
+
+typedef struct submap_copy_t {
+	far_ptr_t tilemap;
+	far_ptr_t tilemap_attr;
+	UWORD source;					// offset of the next row to stage
+	UBYTE source_width;
+	UBYTE dest_x, dest_y, width, height;
+	UBYTE target;
+	UBYTE tile_offset;
+	UBYTE handle;
+} submap_copy_t;
+
+// Copies run in order; only the head one is staged and committed
+static submap_copy_t submap_queue[SUBMAP_QUEUE_SIZE];
+static UBYTE submap_queue_len;
+static UBYTE submap_handle;
+static UBYTE submap_job = JOB_NONE;
+static UBYTE submap_staged, submap_committed;
+
+static UBYTE submap_ring_tiles[SUBMAP_RING_ROWS][32];
+#ifdef CGB
+static UBYTE submap_ring_attrs[SUBMAP_RING_ROWS][32];
+#endif
+
+// Read rows of the head copy from ROM until the ring is full
+static void submap_stage(submap_copy_t * copy) {
+	while ((submap_staged != copy->height) && ((UBYTE)(submap_staged - submap_committed) != SUBMAP_RING_ROWS)) {
+		UBYTE slot = submap_staged & (SUBMAP_RING_ROWS - 1);
+		MemcpyBanked(submap_ring_tiles[slot], (UBYTE *)copy->tilemap.ptr + copy->source, copy->width, copy->tilemap.bank);
+#ifdef CGB
+		if (_is_CGB) {
+			MemcpyBanked(submap_ring_attrs[slot], (UBYTE *)copy->tilemap_attr.ptr + copy->source, copy->width, copy->tilemap_attr.bank);
+		}
+#endif
+		copy->source += copy->source_width;
+		submap_staged++;
+	}
+}
+
+static void submap_set_row(submap_copy_t * copy, UBYTE row, const UBYTE * tiles, UBYTE tile_offset) {
+	UBYTE x = copy->dest_x & 31, y = (copy->dest_y + row) & 31;
+	if (copy->target == SUBMAP_TARGET_WIN) {
+		set_win_based_tiles(x, y, copy->width, 1, tiles, tile_offset);
+	} else {
+		set_bkg_based_tiles(x, y, copy->width, 1, tiles, tile_offset);
+	}
+}
+
+// Write staged rows to VRAM: every attribute row under one bank switch, then the tile rows
+static void submap_commit(submap_copy_t * copy, UBYTE count) {
+	UBYTE last = submap_committed + count;
+#ifdef CGB
+	if (_is_CGB) {
+		VBK_REG = 1;
+		for (UBYTE row = submap_committed; row != last; row++) {
+			submap_set_row(copy, row, submap_ring_attrs[row & (SUBMAP_RING_ROWS - 1)], 0);
+		}
+		VBK_REG = 0;
+	}
+#endif
+	for (UBYTE row = submap_committed; row != last; row++) {
+		submap_set_row(copy, row, submap_ring_tiles[row & (SUBMAP_RING_ROWS - 1)], copy->tile_offset);
+	}
+	submap_committed = last;
+}
+
+// Drop the head copy once all its rows are in VRAM; TRUE if it was
+static UBYTE submap_pop(void) {
+	if (submap_committed != submap_queue[0].height) return FALSE;
+	submap_queue_len--;
+	memmove(submap_queue, submap_queue + 1, submap_queue_len * sizeof(submap_copy_t));
+	submap_staged = submap_committed = 0;
+	return TRUE;
+}
+
+UBYTE submap_copy_step(UBYTE step) OLDCALL BANKED;
+
+// Jobs are dropped on scene change, and the copies queued for the old scene with them
+static void submap_queue_check(void) {
+	if (submap_queue_len && ((submap_job >= MAX_JOBS) || (jobs[submap_job].fn != (void *)submap_copy_step))) {
+		submap_queue_len = 0;
+		submap_staged = submap_committed = 0;
+	}
+}
+
+// Finish every queued copy now, in order
+static void submap_flush(void) {
+	while (submap_queue_len) {
+		submap_stage(submap_queue);
+		submap_commit(submap_queue, submap_staged - submap_committed);
+		submap_pop();
+	}
+}
+
+UBYTE submap_copy_step(UBYTE step) OLDCALL BANKED {
+	step;
+	// a blocking copy may have finished the queue already
+	if (submap_queue_len == 0) return JOB_DONE;
+
+	submap_stage(submap_queue);
+	UBYTE count = submap_staged - submap_committed;
+	if (count > SUBMAP_ROWS_PER_FRAME) count = SUBMAP_ROWS_PER_FRAME;
+	submap_commit(submap_queue, count);
+	if (submap_pop() && (submap_queue_len == 0)) return JOB_DONE;
+	// read ahead now, so next frame's step only writes VRAM
+	submap_stage(submap_queue);
+	// one commit per frame; leave the rest of the budget to other jobs
+	return JOB_YIELD;
+}
+
+/**
+ * Queue a rectangle copy from a scene's tilemap. When the queue is full the
+ * queued copies are finished first.
+ *
+ * @return Handle for vm_submap_copy_wait
+ */
+static UBYTE submap_copy_add(UBYTE scene_bank, const scene_t * scene_ptr, UBYTE source_x, UBYTE source_y, UBYTE dest_x, UBYTE dest_y, UBYTE width, UBYTE height, UBYTE target, UBYTE tile_offset) {
+	if (++submap_handle == SUBMAP_COPY_ALL) submap_handle++;
+	if ((width == 0) || (height == 0)) return submap_handle;
+
+	submap_queue_check();
+	if (submap_queue_len == SUBMAP_QUEUE_SIZE) submap_flush();
+
+	const background_t * bkg = &scene_header_get(scene_bank, scene_ptr)->background;
+	submap_copy_t * copy = submap_queue + submap_queue_len++;
+	copy->tilemap = bkg->tilemap;
+	copy->tilemap_attr = bkg->cgb_tilemap_attr;
+	copy->source = (source_y * (UWORD)bkg->width) + source_x;
+	copy->source_width = bkg->width;
+	copy->dest_x = dest_x, copy->dest_y = dest_y;
+	copy->width = width, copy->height = height;
+	copy->target = target;
+	copy->tile_offset = tile_offset;
+	copy->handle = submap_handle;
+	return submap_handle;
+}
+
+// Run a copy to completion before returning, after any queued ones
+static void submap_copy_now(UBYTE scene_bank, const scene_t * scene_ptr, UBYTE source_x, UBYTE source_y, UBYTE dest_x, UBYTE dest_y, UBYTE width, UBYTE height, UBYTE target, UBYTE tile_offset) {
+	submap_copy_add(scene_bank, scene_ptr, source_x, source_y, dest_x, dest_y, width, height, target, tile_offset);
+	submap_flush();
+}
 
 void set_xy_win_submap(const UBYTE * source, UBYTE bank, UBYTE width, UBYTE x, UBYTE y, UBYTE w, UBYTE h) OLDCALL;
 
@@ -22,21 +180,21 @@ void copy_background_submap_to_overlay(SCRIPT_CTX * THIS) OLDCALL BANKED {
 	uint8_t height = *(int8_t*)VM_REF_TO_PTR(FN_ARG5);
 	uint8_t scene_bank = *(uint8_t *) VM_REF_TO_PTR(FN_ARG6);
 	const scene_t * scene_ptr = *(scene_t **) VM_REF_TO_PTR(FN_ARG7);		
-	scene_t scn;
-    MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-    MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-    unsigned char* tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char* tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;		
-	int16_t offset = (source_y * (int16_t)bkg.width) + source_x;
+	// queued copies land first, as they were started first
+	submap_queue_check();
+	submap_flush();
+	const background_t * bkg = &scene_header_get(scene_bank, scene_ptr)->background;
+    unsigned char* tilemap_ptr = bkg->tilemap.ptr;
+	unsigned char* tilemap_attr_ptr = bkg->cgb_tilemap_attr.ptr;		
+	int16_t offset = (source_y * (int16_t)bkg->width) + source_x;
 #ifdef CGB
     if (_is_CGB) {
         VBK_REG = 1;
-        set_xy_win_submap(tilemap_attr_ptr + offset,  bkg.cgb_tilemap_attr.bank, bkg.width, dest_x, dest_y, width, height);
+        set_xy_win_submap(tilemap_attr_ptr + offset,  bkg->cgb_tilemap_attr.bank, bkg->width, dest_x, dest_y, width, height);
         VBK_REG = 0;
     }
 #endif
-    set_xy_win_submap(tilemap_ptr + offset, bkg.tilemap.bank, bkg.width, dest_x, dest_y, width, height);
+    set_xy_win_submap(tilemap_ptr + offset, bkg->tilemap.bank, bkg->width, dest_x, dest_y, width, height);
 	
 }
 
@@ -48,34 +206,8 @@ void copy_background_submap_to_overlay_base(SCRIPT_CTX * THIS) OLDCALL BANKED {
 	uint8_t scene_bank = *(uint8_t *) VM_REF_TO_PTR(FN_ARG4);
 	const scene_t * scene_ptr = *(scene_t **) VM_REF_TO_PTR(FN_ARG5);	
 
-	UBYTE source_x = bkg_pos & 0xFF;
-	UBYTE source_y = (bkg_pos >> 8) & 0xFF;
-	UBYTE dest_x = dest_pos & 0xFF;
-	UBYTE dest_y = (dest_pos >> 8) & 0xFF;
-	UBYTE width = (wh & 0xFF) & 31;
-	UBYTE height = ((wh >> 8) & 0xFF) & 31;
-	
-	scene_t scn;
-    MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-    MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-    unsigned char* tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char* tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;		
-		
-	UBYTE buffer_size = sizeof(UBYTE) * width;
-	for (uint8_t i = 0; i < height; i++){		
-		int16_t offset = ((source_y + i) * (int16_t)bkg.width) + source_x;
-#ifdef CGB
-		if (_is_CGB) {
-			VBK_REG = 1;
-			MemcpyBanked(tmp_tile_buffer, tilemap_attr_ptr + offset, buffer_size, bkg.cgb_tilemap_attr.bank);
-			set_win_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer);
-			VBK_REG = 0;
-		}
-#endif
-		MemcpyBanked(tmp_tile_buffer, tilemap_ptr + offset, buffer_size, bkg.tilemap.bank);
-		set_win_based_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer, tile_idx_offset);
-	}	
+	submap_copy_now(scene_bank, scene_ptr, bkg_pos & 0xFF, (bkg_pos >> 8) & 0xFF, dest_pos & 0xFF, (dest_pos >> 8) & 0xFF,
+					(wh & 0xFF) & 31, ((wh >> 8) & 0xFF) & 31, SUBMAP_TARGET_WIN, tile_idx_offset);
 }
 
 
@@ -89,28 +221,8 @@ void copy_background_submap_to_background(SCRIPT_CTX * THIS) OLDCALL BANKED {
 	uint8_t height = *(int8_t*)VM_REF_TO_PTR(FN_ARG5) & 31;
 	uint8_t scene_bank = *(uint8_t *) VM_REF_TO_PTR(FN_ARG6);
 	const scene_t * scene_ptr = *(scene_t **) VM_REF_TO_PTR(FN_ARG7);		
-	scene_t scn;
-    MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-    MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-    unsigned char* tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char* tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;		
-	
-	UBYTE buffer_size = sizeof(UBYTE) * width;
-	for (uint8_t i = 0; i < height; i++){		
-		int16_t offset = ((source_y + i) * (int16_t)bkg.width) + source_x;
-#ifdef CGB
-		if (_is_CGB) {
-			VBK_REG = 1;
-			MemcpyBanked(tmp_tile_buffer, tilemap_attr_ptr + offset, buffer_size, bkg.cgb_tilemap_attr.bank);
-			set_bkg_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer);
-			VBK_REG = 0;
-		}
-#endif
-		MemcpyBanked(tmp_tile_buffer, tilemap_ptr + offset, buffer_size, bkg.tilemap.bank);
-		set_bkg_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer);
-	}
-	
+
+	submap_copy_now(scene_bank, scene_ptr, source_x, source_y, dest_x, dest_y, width, height, SUBMAP_TARGET_BKG, 0);
 }
 
 void copy_background_submap_to_background_base(SCRIPT_CTX * THIS) OLDCALL BANKED {
@@ -121,35 +233,42 @@ void copy_background_submap_to_background_base(SCRIPT_CTX * THIS) OLDCALL BANKED
 	uint8_t scene_bank = *(uint8_t *) VM_REF_TO_PTR(FN_ARG4);
 	const scene_t * scene_ptr = *(scene_t **) VM_REF_TO_PTR(FN_ARG5);	
 
-	UBYTE source_x = bkg_pos & 0xFF;
-	UBYTE source_y = (bkg_pos >> 8) & 0xFF;
-	UBYTE dest_x = dest_pos & 0xFF;
-	UBYTE dest_y = (dest_pos >> 8) & 0xFF;
-	UBYTE width = (wh & 0xFF) & 31;
-	UBYTE height = ((wh >> 8) & 0xFF) & 31;
-	
-	scene_t scn;
-    MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-    MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-    unsigned char* tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char* tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;		
-	
-	UBYTE buffer_size = sizeof(UBYTE) * width;	
-	
-	for (uint8_t i = 0; i < height; i++){		
-		int16_t offset = ((source_y + i) * (int16_t)bkg.width) + source_x;
-#ifdef CGB
-		if (_is_CGB) {
-			VBK_REG = 1;
-			MemcpyBanked(tmp_tile_buffer, tilemap_attr_ptr + offset, buffer_size, bkg.cgb_tilemap_attr.bank);
-			set_bkg_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer);
-			VBK_REG = 0;
+	submap_copy_now(scene_bank, scene_ptr, bkg_pos & 0xFF, (bkg_pos >> 8) & 0xFF, dest_pos & 0xFF, (dest_pos >> 8) & 0xFF,
+					(wh & 0xFF) & 31, ((wh >> 8) & 0xFF) & 31, SUBMAP_TARGET_BKG, tile_idx_offset);
+}
+
+// Queued form of the _base copies: a target is added at FN_ARG6 and the handle is written back into FN_ARG0
+void vm_submap_copy_start(SCRIPT_CTX * THIS) OLDCALL BANKED {
+	int16_t bkg_pos = *(int16_t*)VM_REF_TO_PTR(FN_ARG0);
+	int16_t dest_pos = *(int16_t*)VM_REF_TO_PTR(FN_ARG1);
+	int16_t wh = *(int16_t*)VM_REF_TO_PTR(FN_ARG2);
+	uint8_t tile_idx_offset = *(int8_t*)VM_REF_TO_PTR(FN_ARG3);
+	uint8_t scene_bank = *(uint8_t *) VM_REF_TO_PTR(FN_ARG4);
+	const scene_t * scene_ptr = *(scene_t **) VM_REF_TO_PTR(FN_ARG5);	
+	uint8_t target = *(uint8_t *) VM_REF_TO_PTR(FN_ARG6);
+
+	UBYTE handle = submap_copy_add(scene_bank, scene_ptr, bkg_pos & 0xFF, (bkg_pos >> 8) & 0xFF, dest_pos & 0xFF, (dest_pos >> 8) & 0xFF,
+								   (wh & 0xFF) & 31, ((wh >> 8) & 0xFF) & 31, target, tile_idx_offset);
+	if (submap_queue_len) {
+		submap_job = job_start(BANK(COPY_SCENE_PARTS), (void *)submap_copy_step);
+		// no free job slot: copy now, as the blocking form does
+		if (submap_job == JOB_NONE) submap_flush();
+	}
+	*(UWORD *)VM_REF_TO_PTR(FN_ARG0) = handle;
+}
+
+// Wait until the copy with the handle on the stack (or every copy, for 0) is in VRAM
+void vm_submap_copy_wait(SCRIPT_CTX * THIS) OLDCALL BANKED {
+	UBYTE handle = *(uint8_t *) VM_REF_TO_PTR(FN_ARG0);
+	submap_queue_check();
+	for (UBYTE i = 0; i != submap_queue_len; i++) {
+		if ((handle == SUBMAP_COPY_ALL) || (submap_queue[i].handle == handle)) {
+			// call the native again next frame
+			THIS->waitable = TRUE;
+			THIS->PC -= INSTRUCTION_SIZE + sizeof(UBYTE) + sizeof(void *);
+			return;
 		}
-#endif
-		MemcpyBanked(tmp_tile_buffer, tilemap_ptr + offset, buffer_size, bkg.tilemap.bank);
-		set_bkg_based_tiles(dest_x & 31, (dest_y + i) & 31, width, 1, tmp_tile_buffer, tile_idx_offset);
-	}	
+	}
 }
 
 void copy_background_submap_to_tileset(SCRIPT_CTX * THIS) OLDCALL BANKED {	
@@ -169,26 +288,25 @@ void copy_background_submap_to_tileset(SCRIPT_CTX * THIS) OLDCALL BANKED {
 	UBYTE height = ((wh >> 8) & 0xFF) & 31;
 	UBYTE overlay_x = overlay_pos & 0xFF;
 	UBYTE overlay_y = (overlay_pos >> 8) & 0xFF;
+	submap_queue_check();
+	submap_flush();
 			
-	scene_t scn;
-    MemcpyBanked(&scn, scene_ptr, sizeof(scn), scene_bank);
-	background_t bkg;
-    MemcpyBanked(&bkg, scn.background.ptr, sizeof(bkg), scn.background.bank);
-    const tileset_t* tileset = bkg.tileset.ptr;
-	UWORD n_tiles = ReadBankedUWORD(&(tileset->n_tiles), bkg.tileset.bank);
+	const background_t * bkg = &scene_header_get(scene_bank, scene_ptr)->background;
+    const tileset_t* tileset = bkg->tileset.ptr;
+	UWORD n_tiles = ReadBankedUWORD(&(tileset->n_tiles), bkg->tileset.bank);
 	UBYTE ui_reserved_offset = (n_tiles > 128 && n_tiles < 192)? (192 - n_tiles): 0;
-	unsigned char* tilemap_ptr = bkg.tilemap.ptr;
-	unsigned char* tilemap_attr_ptr = bkg.cgb_tilemap_attr.ptr;	
+	unsigned char* tilemap_ptr = bkg->tilemap.ptr;
+	unsigned char* tilemap_attr_ptr = bkg->cgb_tilemap_attr.ptr;	
 	
-	const tileset_t* cgb_tileset = bkg.cgb_tileset.ptr;
+	const tileset_t* cgb_tileset = bkg->cgb_tileset.ptr;
 	
 	UBYTE buffer_size = sizeof(UBYTE) * width;
 	for (uint8_t i = 0; i < height; i++){
-		uint16_t source_offset = ((source_y + i) * (uint16_t)bkg.width) + source_x;
+		uint16_t source_offset = ((source_y + i) * (uint16_t)bkg->width) + source_x;
 		uint16_t dest_offset = ((dest_y + i) * (uint16_t)image_tile_width) + dest_x;
 		for (uint8_t j = 0; j < width; j++){	
 			UBYTE dest_tile = ReadBankedUBYTE(image_ptr + (uint16_t)(dest_offset + j), image_bank);	
-			UBYTE source_tile = ReadBankedUBYTE(tilemap_ptr + (uint16_t)(source_offset + j), bkg.tilemap.bank);
+			UBYTE source_tile = ReadBankedUBYTE(tilemap_ptr + (uint16_t)(source_offset + j), bkg->tilemap.bank);
 			if (ui_reserved_offset && source_tile >= 128){
 				source_tile = source_tile - ui_reserved_offset;
 			}			
@@ -196,7 +314,7 @@ void copy_background_submap_to_tileset(SCRIPT_CTX * THIS) OLDCALL BANKED {
 				if (_is_CGB) {			
 					
 					UBYTE dest_attr = ReadBankedUBYTE(image_attr_ptr + (uint16_t)(dest_offset + j), image_attr_bank);	
-					UBYTE source_attr = ReadBankedUBYTE(tilemap_attr_ptr + (uint16_t)(source_offset + j), bkg.cgb_tilemap_attr.bank);
+					UBYTE source_attr = ReadBankedUBYTE(tilemap_attr_ptr + (uint16_t)(source_offset + j), bkg->cgb_tilemap_attr.bank);
 					if (copy_attributes){						
 						VBK_REG = 1; 
 						if (copy_attributes == 1){
@@ -210,16 +328,16 @@ void copy_background_submap_to_tileset(SCRIPT_CTX * THIS) OLDCALL BANKED {
 						VBK_REG = 1; 
 					}	
 					if (cgb_tileset && (source_attr & 0x08)){
-						SetBankedBkgData(dest_tile, 1, cgb_tileset->tiles + (uint16_t)(source_tile << 4), bkg.cgb_tileset.bank);
+						SetBankedBkgData(dest_tile, 1, cgb_tileset->tiles + (uint16_t)(source_tile << 4), bkg->cgb_tileset.bank);
 					} else {
-						SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg.tileset.bank);
+						SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg->tileset.bank);
 					}
 					VBK_REG = 0;
 				} else {
-					SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg.tileset.bank);
+					SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg->tileset.bank);
 				}					
 			#else				
-				SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg.tileset.bank);				
+				SetBankedBkgData(dest_tile, 1, tileset->tiles + (uint16_t)(source_tile << 4), bkg->tileset.bank);				
 			#endif
 		}
 	}	
@@ -87,6 +87,20 @@ export const fields = [
       value: 0,
     },
   },
+  {
+    key: "spread",
+    label: "Spread copy over several frames",
+    description: "Write a few rows per frame instead of the whole rectangle at once",
+    type: "checkbox",
+    defaultValue: false,
+  },
+  {
+    key: "wait",
+    label: "Wait until finished",
+    type: "checkbox",
+    defaultValue: true,
+    conditions: [{ key: "spread", eq: true }],
+  },
 ];
 
 export const compile = (input, helpers) => {
@@ -132,6 +146,10 @@ export const compile = (input, helpers) => {
           .refSet(tmp2)
           .stop();
   
+  if (input.spread) {
+    // SUBMAP_TARGET_WIN
+    _stackPushConst(1);
+  }
   _stackPushConst(`_${scene.symbol}`);
   _stackPushConst(`___bank_${scene.symbol}`); 
   _stackPush(tmp6);
@@ -139,6 +157,16 @@ export const compile = (input, helpers) => {
   _stackPush(tmp1);
   _stackPush(tmp0);
   		
+  if (input.spread) {
+    // the copy's handle is written back into the source position slot (FN_ARG0)
+    _callNative("vm_submap_copy_start");
+    if (input.wait) {
+      _callNative("vm_submap_copy_wait");
+    }
+    _stackPop(7);
+    return;
+  }
+  
   _callNative("copy_background_submap_to_overlay_base");
   _stackPop(6);  
   
@@ -0,0 +1,28 @@
+export const id = "EVENT_WAIT_FOR_SUBMAP_COPIES";
+export const name = "Wait for spread submap copies";
+export const groups = ["EVENT_GROUP_SCREEN"];
+
+export const autoLabel = (fetchArg) => {
+  return `Wait for spread submap copies`;
+};
+
+export const fields = [
+  {
+    key: "description",
+    type: "label",
+    defaultValue:
+      "Waits until every submap copy spread over several frames (started without waiting) is on screen.",
+  },
+];
+
+export const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, _addComment } = helpers;
+
+  _addComment("Wait for spread submap copies");
+
+  // SUBMAP_COPY_ALL
+  _stackPushConst(0);
+
+  _callNative("vm_submap_copy_wait");
+  _stackPop(1);
+};
@@ -8,34 +8,15 @@
 // SHARED CONSTANTS AND DATA STRUCTURES
 // ============================================================================
 
-// Core geometric constants
-#define PLATFORM_Y_MIN 12
-#define PLATFORM_Y_MAX 19
-#define PLATFORM_X_MIN 2
-#define PLATFORM_X_MAX 21
-#define SEGMENTS_PER_ROW 4
-#define SEGMENT_WIDTH 5
-#define SEGMENT_HEIGHT 2
-#define TOTAL_BLOCKS 16
-
-// Enemy system constants
-#define MAX_ENEMIES 6 // Maximum number of enemy actors supported by the system
-
-// Level code display settings - 24 character display system
-#define LEVEL_CODE_START_X 5
-#define LEVEL_CODE_START_Y 6
-#define LEVEL_CODE_CHARS_TOTAL 24
+// Geometry, level code display settings, tile IDs and pattern tables are
+// generated from tools/level_format/level_format.json
+#include "level_format.h"
 
 // Level code layout:
 // 0-15: Platform patterns (16 blocks)
 // 16: Player column position
 // 17-23: Enemy data (7 chars reserved)
 
-// Platform tile IDs
-#define PLATFORM_TILE_1 4
-#define PLATFORM_TILE_2 5
-#define PLATFORM_TILE_3 6
-
 // Variable IDs for storing level code (define these in GB Studio)
 #define VAR_LEVEL_CODE_PART_1 0 // Platform patterns 0-2   (3×5 bits = 15 bits)
 #define VAR_LEVEL_CODE_PART_2 1 // Platform patterns 3-5   (3×5 bits = 15 bits)
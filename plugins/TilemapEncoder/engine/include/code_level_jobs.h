@@ -0,0 +1,29 @@
+#ifndef CODE_LEVEL_JOBS_H
+#define CODE_LEVEL_JOBS_H
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "code_level_core.h"
+
+// ============================================================================
+// FRAME-SLICED LEVEL REBUILD JOBS
+// ============================================================================
+
+// Rebuild job steps: paint each block, revalidate each block, then finish
+#define LEVEL_JOB_STEP_PAINT 0
+#define LEVEL_JOB_STEP_VALIDATE TOTAL_BLOCKS
+#define LEVEL_JOB_STEP_PLAYER (TOTAL_BLOCKS * 2)
+#define LEVEL_JOB_STEP_DISPLAY (LEVEL_JOB_STEP_PLAYER + 1)
+
+// Start functions return the job ID, or JOB_NONE if the work was done synchronously
+UBYTE start_level_rebuild_job(void) BANKED;
+UBYTE start_restore_level_job(void) BANKED;
+UBYTE start_init_tilemap_editor_job(void) BANKED;
+UBYTE start_load_predefined_level_job(UBYTE level_index) BANKED;
+
+// VM wrapper functions (job ID is written back to FN_ARG0 for vm_job_wait)
+void vm_restore_level_from_memory_job(SCRIPT_CTX *THIS) OLDCALL BANKED;
+void vm_init_tilemap_editor_from_memory_job(SCRIPT_CTX *THIS) OLDCALL BANKED;
+void vm_load_predefined_level_job(SCRIPT_CTX *THIS) OLDCALL BANKED;
+
+#endif // CODE_LEVEL_JOBS_H
@@ -59,10 +59,15 @@ void update_display_with_value(UBYTE char_index, UBYTE value, UBYTE x, UBYTE y)
 // ============================================================================
 
 // String-based level code functions
-void generate_level_code_string(UBYTE level_code_chars[24]) BANKED;
+void generate_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED;
 void save_level_code_string_to_variables(void) BANKED;
 void load_level_code_string_from_variables(void) BANKED;
-void apply_level_code_string(UBYTE level_code_chars[24]) BANKED;
+void apply_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED;
+void decode_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED;
+
+// Variable-length level code (any grid geometry, buffers of LEVEL_CODE_EXT_MAX_CHARS)
+UBYTE generate_level_code_ext(UBYTE *buf) BANKED;
+UBYTE decode_level_code_ext(const UBYTE *buf, UBYTE len) BANKED;
 
 // Individual character management
 void set_level_code_character(UBYTE char_index, UBYTE value) BANKED;
@@ -72,6 +77,7 @@ void clear_level_code_string(void) BANKED;
 
 // Predefined level system
 void load_predefined_level(UBYTE level_index) BANKED;
+UBYTE decode_predefined_level(UBYTE level_index) BANKED;
 UBYTE get_predefined_level_count(void) BANKED;
 
 // VM wrapper functions for string-based level codes
@@ -83,12 +89,15 @@ void vm_set_level_code_character(SCRIPT_CTX *THIS) BANKED;
 void vm_get_level_code_character(SCRIPT_CTX *THIS) BANKED;
 void vm_load_predefined_level(SCRIPT_CTX *THIS) BANKED;
 void vm_get_predefined_level_count(SCRIPT_CTX *THIS) BANKED;
+void vm_save_level_code_ext(SCRIPT_CTX *THIS) OLDCALL BANKED;
+void vm_load_level_code_ext(SCRIPT_CTX *THIS) OLDCALL BANKED;
 
 // ============================================================================
 // SIMPLE MEMORY-BASED RESTORE SYSTEM
 // ============================================================================
 
 // Simple memory-based restore system
+UBYTE has_level_data_in_memory(void) BANKED;
 void restore_level_from_memory(void) BANKED;
 void vm_restore_level_from_memory(SCRIPT_CTX *THIS) BANKED;
 
@@ -98,7 +107,7 @@ void vm_restore_level_from_memory(SCRIPT_CTX *THIS) BANKED;
 
 // IMPORTANT: Update this value to match your GB Studio project
 // This should be the ID of the first variable you allocate for level code storage
-// The system will use 24 consecutive variables starting from this ID
+// The system will use LEVEL_CODE_CHARS_TOTAL consecutive variables starting from this ID
 #define VAR_LEVEL_CODE_CHAR_BASE 50  // Change this to match your GB Studio variables
 
 #endif // CODE_PERSISTENCE_H
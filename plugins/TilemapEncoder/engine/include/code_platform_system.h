@@ -12,15 +12,13 @@
 extern const UBYTE PLATFORM_PATTERNS[];
 extern const UBYTE PATTERN_TILE_MAP[];
 extern const UBYTE EXTENDED_PATTERN_TILE_MAP[];
+extern const UBYTE PATTERN_FROM_BITS[];
+extern const UBYTE PATTERN_EDGE_FLAGS[];
 extern const UBYTE PATTERN_NEIGHBOR_UPDATE_FLAGS[];
 
 // Pattern validation arrays
 extern const UBYTE INVALID_PATTERNS_FIRST_COLUMN[];
 extern const UBYTE INVALID_PATTERNS_LAST_COLUMN[];
-#define INVALID_PATTERNS_FIRST_COLUMN_COUNT 5
-#define INVALID_PATTERNS_LAST_COLUMN_COUNT 5
-
-#define PLATFORM_PATTERN_COUNT 21
 
 // ============================================================================
 // PLATFORM SYSTEM FUNCTIONS
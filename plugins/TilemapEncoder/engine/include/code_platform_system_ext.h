@@ -50,6 +50,9 @@ void extract_platform_data_ext(void) BANKED;
 UBYTE extract_chunk_pattern_ext(UBYTE x, UBYTE y) BANKED;
 UBYTE match_platform_pattern_ext(UBYTE pattern) BANKED;
 
+// Re-extract every unsuppressed block on a platform row in one banked call
+void refresh_row_patterns_ext(UBYTE row_index) BANKED;
+
 // Pattern validation functions (moved from bank 254)
 UBYTE is_pattern_valid_for_position_ext(UBYTE pattern_id, UBYTE block_x) BANKED;
 UBYTE get_next_valid_pattern_ext(UBYTE current_pattern, UBYTE block_x) BANKED;
@@ -63,4 +66,8 @@ void clear_all_suppression_ext(void) BANKED;
 void set_suppress_display_updates_ext(UBYTE suppress) BANKED;
 UBYTE get_suppress_display_updates_ext(void) BANKED;
 
+// Suppression state, readable directly to avoid a far call per check
+extern UBYTE suppressed_blocks[BLOCK_MASK_BYTES];
+extern UBYTE suppress_display_updates;
+
 #endif // CODE_PLATFORM_SYSTEM_EXT_H
@@ -9,8 +9,8 @@
 // ============================================================================
 
 // Valid player position tracking
-extern UBYTE column_has_platform[20];
-extern UBYTE valid_player_columns[20];
+extern UBYTE column_has_platform[PLATFORM_COLUMNS];
+extern UBYTE valid_player_columns[PLATFORM_COLUMNS];
 extern UBYTE valid_player_count;
 
 // ============================================================================
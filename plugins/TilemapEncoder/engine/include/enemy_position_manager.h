@@ -15,8 +15,8 @@
 extern level_code_t current_level_code;
 
 // Shared enemy position constants
-extern const UBYTE ENEMY_ROWS[4];
-extern const UBYTE PLATFORM_ROWS[4];
+extern const UBYTE ENEMY_ROWS[SEGMENT_ROWS];
+extern const UBYTE PLATFORM_ROWS[SEGMENT_ROWS];
 
 // ============================================================================
 // PLATFORM TRACKING SYSTEM
@@ -25,6 +25,9 @@ extern const UBYTE PLATFORM_ROWS[4];
 // Update platform positions cache when platforms change
 void update_platform_positions(void) BANKED;
 
+// Rescan the platform cache of a single platform row (0 to SEGMENT_ROWS - 1)
+void update_platform_positions_row(UBYTE row) BANKED;
+
 // Check if there's a platform directly below an enemy position (cached)
 UBYTE has_platform_below_cached(UBYTE enemy_row, UBYTE col) BANKED;
 
@@ -54,9 +57,16 @@ UBYTE is_valid_enemy_position_for_enemy(UBYTE x, UBYTE y, UBYTE enemy_index) BAN
 // VALID POSITIONS SYSTEM
 // ============================================================================
 
+// Valid enemy positions matrix and its total count
+extern UBYTE valid_enemy_positions[SEGMENT_ROWS][PLATFORM_COLUMNS];
+extern UWORD valid_enemy_positions_count;
+
 // Update the valid enemy positions matrix
 void update_valid_enemy_positions_unified(void) BANKED;
 
+// Update the valid positions of one enemy row after its platform row changed
+void update_valid_enemy_positions_row(UBYTE row) BANKED;
+
 // Get the next valid enemy position for cycling in level code editor
 UBYTE get_next_valid_enemy_position(UBYTE current_row, UBYTE current_col, UBYTE *next_row, UBYTE *next_col) BANKED;
 
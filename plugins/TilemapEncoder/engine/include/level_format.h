@@ -0,0 +1,178 @@
+// GENERATED by tools/level_format/gen_level_format.js from level_format.json
+// Do not edit by hand: change the spec and rerun the generator.
+
+#ifndef LEVEL_FORMAT_H
+#define LEVEL_FORMAT_H
+
+#include "data/states_defines.h"
+#include "level_tiles.h"
+
+// ============================================================================
+// LEVEL GEOMETRY
+// ============================================================================
+
+#define PLATFORM_Y_MIN 12
+#define PLATFORM_Y_MAX 19
+#define PLATFORM_X_MIN 2
+#define PLATFORM_X_MAX 21
+#define SEGMENTS_PER_ROW 4
+#define SEGMENT_ROWS 4
+#define SEGMENT_WIDTH 5
+#define SEGMENT_HEIGHT 2
+#define TOTAL_BLOCKS 16
+
+// Level columns (player and enemy positions are 0-based within these)
+#define PLATFORM_COLUMNS 20
+// The player stands on the row directly above the level
+#define PLAYER_ROW 11
+// Bytes in a one-bit-per-block mask
+#define BLOCK_MASK_BYTES 2
+
+#define MAX_ENEMIES 6 // Maximum number of enemy actors supported by the system
+
+// Enemy rows are the top row of each segment, platforms the bottom row
+#define ENEMY_ROWS_INIT { \
+    12, 14, 16, 18 \
+}
+#define PLATFORM_ROWS_INIT { \
+    13, 15, 17, 19 \
+}
+
+// Map row of a segment row; arithmetic, so usable from any ROM bank
+#define ENEMY_ROW_Y(row) (PLATFORM_Y_MIN + (row) * SEGMENT_HEIGHT)
+#define PLATFORM_ROW_Y(row) (ENEMY_ROW_Y(row) + SEGMENT_HEIGHT - 1)
+
+// Row and column tests on map coordinates
+#define LEVEL_ROW_OFFSET(y) ((UBYTE)((y) - PLATFORM_Y_MIN))
+#define IS_LEVEL_ROW(y) (LEVEL_ROW_OFFSET(y) < (SEGMENT_ROWS * SEGMENT_HEIGHT))
+#define IS_LEVEL_COLUMN(x) ((UBYTE)((x) - PLATFORM_X_MIN) < PLATFORM_COLUMNS)
+#define IS_ENEMY_ROW(y) (IS_LEVEL_ROW(y) && (LEVEL_ROW_OFFSET(y) % SEGMENT_HEIGHT) == 0)
+#define IS_PLATFORM_ROW(y) (IS_LEVEL_ROW(y) && (LEVEL_ROW_OFFSET(y) % SEGMENT_HEIGHT) == (SEGMENT_HEIGHT - 1))
+// Segment row (0 to SEGMENT_ROWS - 1) of a map row inside the level
+#define SEGMENT_ROW_OF(y) (LEVEL_ROW_OFFSET(y) / SEGMENT_HEIGHT)
+
+// One-bit-per-block masks (UBYTE mask[BLOCK_MASK_BYTES])
+#define BLOCK_MASK_TEST(mask, i) ((mask)[(i) >> 3] & (1 << ((i) & 7)))
+#define BLOCK_MASK_SET(mask, i) ((mask)[(i) >> 3] |= (1 << ((i) & 7)))
+#define BLOCK_MASK_CLEAR(mask, i) ((mask)[(i) >> 3] &= ~(1 << ((i) & 7)))
+
+// The level must fit the MetaTile8 map buffer
+#if defined(MAX_MAP_DATA_WIDTH) && (PLATFORM_X_MAX >= MAX_MAP_DATA_WIDTH)
+#error "level_format.json: level is wider than MAX_MAP_DATA_WIDTH"
+#endif
+#if defined(MAX_MAP_DATA_HEIGHT) && (PLATFORM_Y_MAX >= MAX_MAP_DATA_HEIGHT)
+#error "level_format.json: level is taller than MAX_MAP_DATA_HEIGHT"
+#endif
+
+// ============================================================================
+// LEVEL CODE LAYOUT
+// ============================================================================
+
+#define LEVEL_CODE_START_X 5
+#define LEVEL_CODE_START_Y 6
+
+// Fixed code: patterns, player column, enemy positions, odd mask, directions
+#define LEVEL_CODE_PLAYER_INDEX 16
+#define LEVEL_CODE_ENEMY_INDEX 17
+#define LEVEL_CODE_ENEMY_POSITIONS 5
+#define LEVEL_CODE_ENEMY_CHARS 7
+#define LEVEL_CODE_ODD_MASK_INDEX 22
+#define LEVEL_CODE_DIRECTION_INDEX 23
+#define LEVEL_CODE_CHARS_TOTAL 24
+
+// On-screen layout: rows of three 4-character groups, one update bit per character
+#define LEVEL_CODE_CHARS_PER_ROW 12
+#define LEVEL_CODE_DISPLAY_ROWS 2
+#define LEVEL_CODE_MASK_BYTES 3
+
+// Enemy position values: 1 + segment row * ENEMY_ANCHORS_PER_ROW + column / 2
+#define ENEMY_ANCHORS_PER_ROW 10
+#define ENEMY_POS_MAX 40
+
+// 1 when every value of the fixed code fits a single POS41 character;
+// otherwise only the variable-length code round-trips the whole level
+#define LEVEL_CODE_LEGACY 1
+
+// Variable-length code: [segments per row, segment rows] patterns
+// [player column hi, lo] [enemy count] then per enemy [row, column hi, lo, direction]
+#define LEVEL_CODE_EXT_HEADER_CHARS 2
+#define LEVEL_CODE_EXT_PLAYER_CHARS 2
+#define LEVEL_CODE_EXT_ENEMY_CHARS 4
+#define LEVEL_CODE_EXT_MIN_CHARS 21
+#define LEVEL_CODE_EXT_MAX_CHARS 45
+
+// Platform tile IDs
+#define PLATFORM_TILE_1 4
+#define PLATFORM_TILE_2 5
+#define PLATFORM_TILE_3 6
+
+// ============================================================================
+// PLATFORM PATTERNS
+// ============================================================================
+
+#define PLATFORM_PATTERN_COUNT 21
+#define PATTERN_NONE 0xFF
+#define PATTERN_BITS_MASK 0x1F
+
+// 5-bit row masks, leftmost tile in the high bit
+#define PLATFORM_PATTERNS_INIT { \
+    0x00, 0x01, 0x10, 0x03, 0x18, 0x06, 0x0C, 0x07, 0x1C, 0x0D, \
+    0x16, 0x0E, 0x0F, 0x1E, 0x11, 0x13, 0x19, 0x17, 0x1D, 0x1B, \
+    0x1F \
+}
+
+// Row mask -> pattern ID, PATTERN_NONE for masks no pattern produces
+#define PATTERN_FROM_BITS_INIT { \
+    0x00, 0x01, 0xFF, 0x03, 0xFF, 0xFF, 0x05, 0x07, 0xFF, 0xFF, \
+    0xFF, 0xFF, 0x06, 0x09, 0x0B, 0x0C, 0x02, 0x0E, 0xFF, 0x0F, \
+    0xFF, 0xFF, 0x0A, 0x11, 0x04, 0x10, 0xFF, 0x13, 0x08, 0x12, \
+    0x0D, 0x14 \
+}
+
+// Pattern ID -> PATTERN_NEEDS_* flags: a lone tile on the block edge
+// needs a neighbouring block, so the pattern is invalid in that outer column
+#define PATTERN_NEEDS_LEFT 0x01
+#define PATTERN_NEEDS_RIGHT 0x02
+#define PATTERN_EDGE_FLAGS_INIT { \
+    0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, \
+    0x01, 0x00, 0x00, 0x00, 0x03, 0x01, 0x02, 0x01, 0x02, 0x00, \
+    0x00 \
+}
+
+// Patterns with a lone tile on the left/right edge (need a neighbour block)
+#define INVALID_PATTERNS_FIRST_COLUMN_COUNT 5
+#define INVALID_PATTERNS_LAST_COLUMN_COUNT 5
+#define INVALID_PATTERNS_FIRST_COLUMN_INIT { \
+    2, 10, 14, 15, 17 \
+}
+#define INVALID_PATTERNS_LAST_COLUMN_INIT { \
+    1, 9, 14, 16, 18 \
+}
+
+// Pattern display characters
+#define PATTERN_TILE_MAP_INIT { \
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, \
+    58, 59, 60, 61, 62, 63, 64, 65, 66, 67, \
+    68 \
+}
+#define EXTENDED_PATTERN_TILE_MAP_INIT { \
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, \
+    58, 59, 60, 61, 62, 63, 64, 65, 66, 67, \
+    68, 69, 70, 71, 72, 73, 74, 75, 76, 77, \
+    78, 79, 80, 81, 82 \
+}
+
+// ============================================================================
+// PREDEFINED LEVELS
+// ============================================================================
+
+// Fixed level codes, LEVEL_CODE_CHARS_TOTAL values per row
+#define PREDEFINED_LEVEL_COUNT 2
+#define PREDEFINED_LEVELS_INIT { \
+    /* Level 0: Simple starting level */ \
+    {{ 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 10, 0, 0, 0, 0, 0, 0, 0 }}, \
+    /* Level 1: More complex level */ \
+    {{ 5, 3, 1, 7, 2, 4, 6, 8, 1, 3, 5, 7, 2, 4, 6, 8, 5, 15, 25, 35, 0, 0, 7, 3 }} \
+}
+
+#endif // LEVEL_FORMAT_H
@@ -0,0 +1,47 @@
+// GENERATED by tools/level_format/gen_level_format.js from level_format.json
+// Do not edit by hand: change the spec and rerun the generator.
+
+#ifndef LEVEL_TILES_H
+#define LEVEL_TILES_H
+
+// ============================================================================
+// METATILES
+// ============================================================================
+
+#define TILE_EMPTY 0
+#define TILE_PLATFORM_LEFT 4
+#define TILE_PLATFORM_MIDDLE 5
+#define TILE_PLATFORM_RIGHT 6
+#define TILE_PLAYER 20
+#define TILE_RIGHT_ENEMY 21
+#define TILE_LEFT_ENEMY 22
+#define TILE_EXIT_TOP_LEFT 16
+#define TILE_EXIT_TOP_RIGHT 17
+#define TILE_EXIT_BOTTOM_LEFT 32
+#define TILE_EXIT_BOTTOM_RIGHT 33
+#define TILE_0 48
+
+// Brush tile type constants
+#define BRUSH_TILE_EMPTY 0
+#define BRUSH_TILE_PLATFORM 1
+#define BRUSH_TILE_ENEMY_R 2
+#define BRUSH_TILE_ENEMY_L 3
+#define BRUSH_TILE_EXIT 4
+#define BRUSH_TILE_PLAYER 5
+#define BRUSH_TILE_OTHER 6
+
+// ============================================================================
+// CHARACTER TILES
+// ============================================================================
+
+// Every code value v is drawn with metatile CHAR_TILE_BASE + v
+#define CHAR_TILE_BASE 48
+#define POS41_VALUE_COUNT 41
+#define BASE32_VALUE_COUNT 32
+#define CHAR_VALUE_EXTENDED_MAX 48
+
+// Character tile range constants for cycling
+#define TILE_CHAR_FIRST 48
+#define TILE_CHAR_LAST 88
+
+#endif // LEVEL_TILES_H
@@ -42,7 +42,7 @@ UBYTE get_enemy_row_from_position(UBYTE enemy_index) BANKED
         return current_level_code.enemy_rows[enemy_index];
 
     // Default row if none is set
-    return enemy_index % 4; // Distribute across rows 0-3
+    return enemy_index % SEGMENT_ROWS; // Distribute across the segment rows
 }
 
 // ============================================================================
@@ -78,12 +78,12 @@ UBYTE encode_enemy_position(UBYTE enemy_index) BANKED
     UBYTE col = current_level_code.enemy_positions[enemy_index];
     UBYTE row = get_enemy_row_from_position(enemy_index);
 
-    // Calculate index: 1 + row*10 + anchor (where anchor = col/2)
+    // Calculate index: 1 + row*ENEMY_ANCHORS_PER_ROW + anchor (where anchor = col/2)
     UBYTE anchor = col / 2;
-    UBYTE idx = 1 + row * 10 + anchor;
+    UBYTE idx = 1 + row * ENEMY_ANCHORS_PER_ROW + anchor;
 
-    // Safety check - value must be in range 1-40
-    if (idx > 40)
+    // Safety check - value must fit a single POS41 character
+    if (idx > ENEMY_POS_MAX || idx >= POS41_VALUE_COUNT)
         return 0; // Invalid index
 
     return idx;
@@ -190,15 +190,15 @@ void decode_enemy_position(UBYTE enemy_index, UBYTE pos_value, UBYTE odd_bit, UB
         return;
     }
 
-    // Decode: pos_value = 1 + row*10 + anchor
-    UBYTE v = pos_value - 1; // 0-39
-    UBYTE row = v / 10;      // 0-3
-    UBYTE anchor = v % 10;   // 0-9
+    // Decode: pos_value = 1 + row*ENEMY_ANCHORS_PER_ROW + anchor
+    UBYTE v = pos_value - 1;                  // 0 to ENEMY_POS_MAX - 1
+    UBYTE row = v / ENEMY_ANCHORS_PER_ROW;     // Segment row
+    UBYTE anchor = v % ENEMY_ANCHORS_PER_ROW;
 
     // Calculate actual column: anchor*2 + odd_bit
     UBYTE col = anchor * 2 + odd_bit;
 
-    if (col > 19 || row > 3) // Safety check
+    if (col >= PLATFORM_COLUMNS || row >= SEGMENT_ROWS) // Safety check
     {
         current_level_code.enemy_positions[enemy_index] = 255;
         current_level_code.enemy_rows[enemy_index] = 255;
@@ -207,7 +207,7 @@ void decode_enemy_position(UBYTE enemy_index, UBYTE pos_value, UBYTE odd_bit, UB
 
     // Validate position to prevent enemy stacking (simplified for code-based placement)
     UBYTE tilemap_x = PLATFORM_X_MIN + col;
-    UBYTE tilemap_y = ENEMY_ROWS[row];
+    UBYTE tilemap_y = ENEMY_ROW_Y(row);
     
     // Only check for direct enemy conflicts, not platform requirements
     // Platform validation is handled by the paint system, not code system
@@ -236,19 +236,8 @@ void decode_enemy_position(UBYTE enemy_index, UBYTE pos_value, UBYTE odd_bit, UB
     // Update the enemy actor position (no background tile manipulation)
     // Reuse the tilemap_x variable already declared above
     
-    // Use the same row-to-Y mapping as the paint system (no offset)
-    UBYTE actual_y;
-    if (row == 0)
-        actual_y = 12;
-    else if (row == 1)
-        actual_y = 14;
-    else if (row == 2)
-        actual_y = 16;
-    else
-        actual_y = 18;
-
     // Update the enemy actor position
-    place_enemy_actor(enemy_index, tilemap_x, actual_y, dir_bit);
+    place_enemy_actor(enemy_index, tilemap_x, tilemap_y, dir_bit);
 }
 
 // Decode full enemy data from numeric values array
@@ -262,8 +251,8 @@ void decode_enemy_data_from_values(const UBYTE *enemy_values) BANKED
     }
 
     // Get masks directly (no character conversion needed)
-    UBYTE odd_mask = enemy_values[5] & 0x1F; // Character 22
-    UBYTE dir_mask = enemy_values[6] & 0x1F; // Character 23
+    UBYTE odd_mask = enemy_values[LEVEL_CODE_ENEMY_POSITIONS] & 0x1F;     // Odd mask character
+    UBYTE dir_mask = enemy_values[LEVEL_CODE_ENEMY_POSITIONS + 1] & 0x1F; // Direction character
 
     // Clear enemy data
     current_level_code.enemy_directions = 0;
@@ -274,7 +263,7 @@ void decode_enemy_data_from_values(const UBYTE *enemy_values) BANKED
     }
 
     // Decode each enemy position (values 0-4 = positions 0-4)
-    for (UBYTE k = 0; k < 5; k++)
+    for (UBYTE k = 0; k < LEVEL_CODE_ENEMY_POSITIONS; k++)
     {
         UBYTE odd_bit = (odd_mask >> k) & 1;
         UBYTE dir_bit = (dir_mask >> k) & 1;
@@ -289,11 +278,11 @@ void decode_enemy_data_from_values(const UBYTE *enemy_values) BANKED
 // Handle enemy data edit from level code (called when user edits character 17-23)
 void handle_enemy_data_edit(UBYTE char_index, UBYTE new_value) BANKED
 {
-    if (char_index < 17 || char_index > 23)
+    if (char_index < LEVEL_CODE_ENEMY_INDEX || char_index > LEVEL_CODE_DIRECTION_INDEX)
         return; // Not an enemy character
 
     // Build current enemy values array for decoding
-    UBYTE enemy_values[7];
+    UBYTE enemy_values[LEVEL_CODE_ENEMY_CHARS];
 
     // Get current encoded values directly
     enemy_values[0] = encode_enemy_positions();  // Character 17
@@ -305,9 +294,9 @@ void handle_enemy_data_edit(UBYTE char_index, UBYTE new_value) BANKED
     enemy_values[6] = encode_enemy_directions(); // Character 23
 
     // Update the edited value
-    UBYTE rel_index = char_index - 17; // Convert to 0-6 range
+    UBYTE rel_index = char_index - LEVEL_CODE_ENEMY_INDEX; // Convert to 0-6 range
 
-    if (rel_index < 5) // Position characters (17-21)
+    if (rel_index < LEVEL_CODE_ENEMY_POSITIONS) // Position characters (17-21)
     {
         // Position character (0-4) - validate position value
         if (new_value == 0)
@@ -315,35 +304,25 @@ void handle_enemy_data_edit(UBYTE char_index, UBYTE new_value) BANKED
             // 0 = no enemy is always valid
             enemy_values[rel_index] = 0;
         }
-        else if (new_value <= 40) // Valid POS41 range
+        else if (new_value <= ENEMY_POS_MAX) // Valid POS41 range
         {
             // For position values, we need to check if this is a valid position
             // Convert POS41 value to row/column
-            UBYTE v = new_value - 1; // 0-39
-            UBYTE row = v / 10;      // 0-3
-            UBYTE anchor = v % 10;   // 0-9
+            UBYTE v = new_value - 1;                  // 0 to ENEMY_POS_MAX - 1
+            UBYTE row = v / ENEMY_ANCHORS_PER_ROW;     // Segment row
+            UBYTE anchor = v % ENEMY_ANCHORS_PER_ROW;
 
             // Get the odd bit for this enemy
-            UBYTE odd_bit = (enemy_values[5] >> rel_index) & 1;
+            UBYTE odd_bit = (enemy_values[LEVEL_CODE_ENEMY_POSITIONS] >> rel_index) & 1;
 
             // Calculate actual column: anchor*2 + odd_bit
             UBYTE col = anchor * 2 + odd_bit;
 
-            if (row < 4 && col < 20)
+            if (row < SEGMENT_ROWS && col < PLATFORM_COLUMNS)
             {
                 // Convert to tilemap coordinates for validation
                 UBYTE x = PLATFORM_X_MIN + col;
-                UBYTE y;
-                
-                // Use the same row-to-Y mapping as the paint system
-                if (row == 0)
-                    y = 12;
-                else if (row == 1)
-                    y = 14;
-                else if (row == 2)
-                    y = 16;
-                else
-                    y = 18;
+                UBYTE y = ENEMY_ROW_Y(row);
 
                 // Use enemy-specific validation that properly handles spacing
                 if (is_position_valid_for_enemy(rel_index, x, y))
@@ -369,7 +348,7 @@ void handle_enemy_data_edit(UBYTE char_index, UBYTE new_value) BANKED
         if (new_value <= 31) // Valid BASE32 range
         {
             // Additional validation for character 22 (offset mask)
-            if (rel_index == 5) // Character 22 (offset mask)
+            if (rel_index == LEVEL_CODE_ENEMY_POSITIONS) // Character 22 (offset mask)
             {
                 if (is_valid_offset_mask(new_value))
                 {
@@ -534,15 +513,7 @@ void restore_enemy_actors_from_level_code(void) BANKED
             UBYTE tilemap_x = PLATFORM_X_MIN + col;  // Convert column to tilemap X
             
             // Use the same row-to-Y mapping as the paint system (no offset)
-            UBYTE tilemap_y;
-            if (row == 0)
-                tilemap_y = 12;
-            else if (row == 1)
-                tilemap_y = 14;
-            else if (row == 2)
-                tilemap_y = 16;
-            else
-                tilemap_y = 18;
+            UBYTE tilemap_y = ENEMY_ROW_Y(row);
             
             // Get direction for this enemy (bit i in enemy_directions)
             UBYTE direction = (current_level_code.enemy_directions & (1 << i)) ? 1 : 0;
@@ -21,33 +21,23 @@ UBYTE is_pos41_value_brush_valid(UBYTE enemy_index, UBYTE pos_value, UBYTE odd_b
     if (pos_value == 0)
         return 1; // 0 = no enemy is always valid
 
-    if (pos_value > 40)
+    if (pos_value > ENEMY_POS_MAX)
         return 0; // Invalid POS41 range
 
     // Convert POS41 value to row and column
-    UBYTE v = pos_value - 1; // 0-39
-    UBYTE row = v / 10;      // 0-3
-    UBYTE anchor = v % 10;   // 0-9
+    UBYTE v = pos_value - 1;                  // 0 to ENEMY_POS_MAX - 1
+    UBYTE row = v / ENEMY_ANCHORS_PER_ROW;     // Segment row
+    UBYTE anchor = v % ENEMY_ANCHORS_PER_ROW;
 
     // Calculate actual column: anchor*2 + odd_bit
     UBYTE col = anchor * 2 + odd_bit;
 
-    if (row >= 4 || col >= 20)
+    if (row >= SEGMENT_ROWS || col >= PLATFORM_COLUMNS)
         return 0; // Invalid coordinates
 
     // Convert to tilemap coordinates
     UBYTE x = PLATFORM_X_MIN + col;
-    UBYTE y;
-    
-    // Use the same row-to-Y mapping as the paint system
-    if (row == 0)
-        y = 12;
-    else if (row == 1)
-        y = 14;
-    else if (row == 2)
-        y = 16;
-    else
-        y = 18;
+    UBYTE y = ENEMY_ROW_Y(row);
 
     // Temporarily clear this enemy's position to avoid self-conflict during validation
     UBYTE old_pos = current_level_code.enemy_positions[enemy_index];
@@ -69,7 +59,7 @@ UBYTE is_pos41_value_brush_valid(UBYTE enemy_index, UBYTE pos_value, UBYTE odd_b
 UBYTE find_next_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE odd_bit) BANKED
 {
     // First check if the current position is valid (needed for when users try to enter an invalid position)
-    if (current_pos > 0 && current_pos <= 40)
+    if (current_pos > 0 && current_pos <= ENEMY_POS_MAX)
     {
         if (is_pos41_value_brush_valid(enemy_index, current_pos, odd_bit))
             return current_pos;
@@ -78,8 +68,8 @@ UBYTE find_next_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE od
     // Start searching from the next position after current
     UBYTE start_pos = (current_pos == 0) ? 1 : current_pos + 1;
     
-    // Search forward from start_pos to 40
-    for (UBYTE pos = start_pos; pos <= 40; pos++)
+    // Search forward from start_pos to ENEMY_POS_MAX
+    for (UBYTE pos = start_pos; pos <= ENEMY_POS_MAX; pos++)
     {
         if (is_pos41_value_brush_valid(enemy_index, pos, odd_bit))
             return pos;
@@ -100,14 +90,14 @@ UBYTE find_next_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE od
 UBYTE find_prev_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE odd_bit) BANKED
 {
     // First check if the current position is valid (needed for when users try to enter an invalid position)
-    if (current_pos > 0 && current_pos <= 40)
+    if (current_pos > 0 && current_pos <= ENEMY_POS_MAX)
     {
         if (is_pos41_value_brush_valid(enemy_index, current_pos, odd_bit))
             return current_pos;
     }
     
     // Start searching from the previous position before current
-    UBYTE start_pos = (current_pos <= 1) ? 40 : current_pos - 1;
+    UBYTE start_pos = (current_pos <= 1) ? ENEMY_POS_MAX : current_pos - 1;
     
     // Search backward from start_pos to 1
     for (UBYTE pos = start_pos; pos >= 1; pos--)
@@ -116,8 +106,8 @@ UBYTE find_prev_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE od
             return pos;
     }
     
-    // If nothing found backward, search from 40 down to current_pos
-    for (UBYTE pos = 40; pos > start_pos; pos--)
+    // If nothing found backward, search from ENEMY_POS_MAX down to current_pos
+    for (UBYTE pos = ENEMY_POS_MAX; pos > start_pos; pos--)
     {
         if (is_pos41_value_brush_valid(enemy_index, pos, odd_bit))
             return pos;
@@ -135,12 +125,12 @@ UBYTE find_prev_brush_valid_pos41(UBYTE enemy_index, UBYTE current_pos, UBYTE od
 // Used when user presses right arrow or cycles through codes
 UBYTE cycle_to_next_valid_enemy_code(UBYTE char_index) BANKED
 {
-    if (char_index < 17 || char_index > 23)
+    if (char_index < LEVEL_CODE_ENEMY_INDEX || char_index > LEVEL_CODE_DIRECTION_INDEX)
         return 0; // Not an enemy character
 
-    UBYTE rel_index = char_index - 17; // Convert to 0-6 range
+    UBYTE rel_index = char_index - LEVEL_CODE_ENEMY_INDEX; // Convert to 0-6 range
 
-    if (rel_index < 5) // Position characters (17-21)
+    if (rel_index < LEVEL_CODE_ENEMY_POSITIONS) // Position characters (17-21)
     {
         // Get current values
         UBYTE current_pos = encode_enemy_position(rel_index);
@@ -151,7 +141,7 @@ UBYTE cycle_to_next_valid_enemy_code(UBYTE char_index) BANKED
         UBYTE next_pos = find_next_brush_valid_pos41(rel_index, current_pos, odd_bit);
         return next_pos;
     }
-    else if (rel_index == 5) // Odd mask (character 22)
+    else if (rel_index == LEVEL_CODE_ENEMY_POSITIONS) // Odd mask (character 22)
     {
         // For odd mask, we need to find the next valid mask value
         // This is more complex as changing odd bits affects all enemy positions
@@ -195,12 +185,12 @@ UBYTE cycle_to_next_valid_enemy_code(UBYTE char_index) BANKED
 // Used when user presses left arrow or cycles backwards through codes
 UBYTE cycle_to_prev_valid_enemy_code(UBYTE char_index) BANKED
 {
-    if (char_index < 17 || char_index > 23)
+    if (char_index < LEVEL_CODE_ENEMY_INDEX || char_index > LEVEL_CODE_DIRECTION_INDEX)
         return 0; // Not an enemy character
 
-    UBYTE rel_index = char_index - 17; // Convert to 0-6 range
+    UBYTE rel_index = char_index - LEVEL_CODE_ENEMY_INDEX; // Convert to 0-6 range
 
-    if (rel_index < 5) // Position characters (17-21)
+    if (rel_index < LEVEL_CODE_ENEMY_POSITIONS) // Position characters (17-21)
     {
         // Get current values
         UBYTE current_pos = encode_enemy_position(rel_index);
@@ -211,7 +201,7 @@ UBYTE cycle_to_prev_valid_enemy_code(UBYTE char_index) BANKED
         UBYTE prev_pos = find_prev_brush_valid_pos41(rel_index, current_pos, odd_bit);
         return prev_pos;
     }
-    else if (rel_index == 5) // Odd mask (character 22)
+    else if (rel_index == LEVEL_CODE_ENEMY_POSITIONS) // Odd mask (character 22)
     {
         // For odd mask, find the previous valid mask value
         UBYTE current_mask = encode_odd_mask_value();
@@ -253,14 +243,14 @@ UBYTE cycle_to_prev_valid_enemy_code(UBYTE char_index) BANKED
 // Check if a specific enemy code value would be valid according to brush system
 UBYTE is_enemy_code_brush_valid(UBYTE char_index, UBYTE test_value) BANKED
 {
-    if (char_index < 17 || char_index > 23)
+    if (char_index < LEVEL_CODE_ENEMY_INDEX || char_index > LEVEL_CODE_DIRECTION_INDEX)
         return 0; // Not an enemy character
 
-    UBYTE rel_index = char_index - 17; // Convert to 0-6 range
+    UBYTE rel_index = char_index - LEVEL_CODE_ENEMY_INDEX; // Convert to 0-6 range
 
-    if (rel_index < 5) // Position characters (17-21)
+    if (rel_index < LEVEL_CODE_ENEMY_POSITIONS) // Position characters (17-21)
     {
-        if (test_value > 40)
+        if (test_value > ENEMY_POS_MAX)
             return 0; // Invalid POS41 range
 
         // Get the odd bit for this enemy
@@ -270,7 +260,7 @@ UBYTE is_enemy_code_brush_valid(UBYTE char_index, UBYTE test_value) BANKED
         // Test if the brush would allow this position
         return is_pos41_value_brush_valid(rel_index, test_value, odd_bit);
     }
-    else if (rel_index == 5) // Odd mask (character 22)
+    else if (rel_index == LEVEL_CODE_ENEMY_POSITIONS) // Odd mask (character 22)
     {
         if (test_value > 31)
             return 0; // Invalid BASE32 range
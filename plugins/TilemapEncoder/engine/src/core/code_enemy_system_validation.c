@@ -17,14 +17,13 @@
 // External function declarations
 extern UBYTE get_enemy_row_from_position(UBYTE enemy_index) BANKED;
 extern void delete_enemy(UBYTE x, UBYTE y) BANKED;
-extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED;
+extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) NONBANKED;
 extern UBYTE is_valid_platform_row(UBYTE y) BANKED;
 extern UBYTE has_enemy_nearby(UBYTE x, UBYTE y) BANKED;
 extern UBYTE has_enemy_actor_at_position(UBYTE x, UBYTE y) BANKED;
 
-// Valid enemy positions tracking - now managed by unified system
-extern UBYTE valid_enemy_positions[4][20];
-extern UBYTE valid_enemy_positions_count;
+// Valid enemy positions tracking (valid_enemy_positions) is managed by the
+// unified system in enemy_position_manager.h
 
 // Use shared enemy position constants from enemy position manager
 
@@ -32,22 +31,19 @@ extern UBYTE valid_enemy_positions_count;
 // UTILITY FUNCTIONS
 // ============================================================================
 
-// Convert from level row (0-3) to actual y position (12, 14, 16, 18)
+// Convert from level row (0 to SEGMENT_ROWS - 1) to actual y position
 UBYTE get_enemy_y_from_row(UBYTE row) BANKED
 {
-    if (row < 4)
+    if (row < SEGMENT_ROWS)
         return ENEMY_ROWS[row];
-    return 12; // Default to first row if invalid
+    return ENEMY_ROWS[0]; // Default to first row if invalid
 }
 
-// Convert from actual y position to level row (0-3)
+// Convert from actual y position to level row (0 to SEGMENT_ROWS - 1)
 UBYTE get_enemy_row_from_y(UBYTE y) BANKED
 {
-    for (UBYTE i = 0; i < 4; i++)
-    {
-        if (ENEMY_ROWS[i] == y)
-            return i;
-    }
+    if (IS_ENEMY_ROW(y))
+        return SEGMENT_ROW_OF(y);
     return 0; // Default to row 0 if not found
 }
 
@@ -72,8 +68,8 @@ UBYTE has_platform_below_enemy(UBYTE x, UBYTE y) BANKED
 // Check if a position is directly below the player
 UBYTE is_below_player(UBYTE x) BANKED
 {
-    // Player is at column 2-21 in tilemap, corresponding to 0-19 in level code
-    UBYTE player_x = current_level_code.player_column + 2;
+    // Level code columns start at PLATFORM_X_MIN in the tilemap
+    UBYTE player_x = current_level_code.player_column + PLATFORM_X_MIN;
     return (x == player_x);
 }
 
@@ -82,7 +78,7 @@ UBYTE is_above_exit(UBYTE x, UBYTE y) BANKED
 {
     // Exit is typically at the right edge of platforms
     // For now, we'll just check player column + 1 (simple approximation)
-    UBYTE exit_x = current_level_code.player_column + 3; // Player + 1 tile
+    UBYTE exit_x = current_level_code.player_column + PLATFORM_X_MIN + 1; // Player + 1 tile
 
     // Check all rows below this position for exit
     for (UBYTE check_y = y + 1; check_y <= PLATFORM_Y_MAX; check_y++)
@@ -136,46 +132,18 @@ UBYTE is_position_valid_for_enemy(UBYTE enemy_index, UBYTE x, UBYTE y) BANKED
 // Initialize the valid enemy position tracking system
 void init_valid_enemy_positions(void) BANKED
 {
-    // Clear all tracking arrays
-    for (UBYTE row = 0; row < 4; row++)
-    {
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            valid_enemy_positions[row][col] = 0;
-        }
-    }
-
-    valid_enemy_positions_count = 0;
-
     // Scan the level for valid enemy positions using unified system
+    // (clears and recounts every row)
     update_valid_enemy_positions_unified();
 }
 
 // Update valid enemy positions by scanning the entire level
 void update_valid_enemy_positions(void) BANKED
 {
-    valid_enemy_positions_count = 0;
-
-    // Check all four enemy rows
-    for (UBYTE row = 0; row < 4; row++)
+    // Row by row so the per-row counts stay in step with the matrix
+    for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
     {
-        UBYTE y = get_enemy_y_from_row(row);
-
-        // Check all columns
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            UBYTE x = PLATFORM_X_MIN + col;
-
-            // First clear this position
-            valid_enemy_positions[row][col] = 0;
-
-            // Now check if position is valid - must have a platform directly below
-            if (is_valid_enemy_position(x, y))
-            {
-                valid_enemy_positions[row][col] = 1;
-                valid_enemy_positions_count++;
-            }
-        }
+        update_valid_enemy_positions_row(row);
     }
 }
 
@@ -201,12 +169,12 @@ void find_next_valid_enemy_position_in_code(UBYTE enemy_index, UBYTE *pos_value,
     UBYTE current_row = get_enemy_row_from_position(enemy_index);
     
     // Cycle through positions that match the current odd bit
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (current_row + row_offset) % 4;
+        UBYTE row = (current_row + row_offset) % SEGMENT_ROWS;
         UBYTE start_col = (row_offset == 0) ? current_col + 1 : 0;
         
-        for (UBYTE col = start_col; col < 20; col++)
+        for (UBYTE col = start_col; col < PLATFORM_COLUMNS; col++)
         {
             // Only consider columns that match the current odd bit
             if ((col % 2) != current_odd_bit)
@@ -223,7 +191,7 @@ void find_next_valid_enemy_position_in_code(UBYTE enemy_index, UBYTE *pos_value,
                 {
                     // Found a valid position with the same odd bit
                     UBYTE anchor = col / 2;
-                    *pos_value = 1 + row * 10 + anchor;
+                    *pos_value = 1 + row * ENEMY_ANCHORS_PER_ROW + anchor;
                     // *odd_bit and *dir_bit remain unchanged
                     return;
                 }
@@ -242,14 +210,14 @@ void find_prev_valid_enemy_position_in_code(UBYTE enemy_index, UBYTE *pos_value,
     UBYTE current_odd_bit = *odd_bit;
     
     // Get current position
-    UBYTE current_col = (current_level_code.enemy_positions[enemy_index] != 255) ? current_level_code.enemy_positions[enemy_index] : 19;
+    UBYTE current_col = (current_level_code.enemy_positions[enemy_index] != 255) ? current_level_code.enemy_positions[enemy_index] : (PLATFORM_COLUMNS - 1);
     UBYTE current_row = get_enemy_row_from_position(enemy_index);
     
     // Cycle backward through positions that match the current odd bit
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (4 + current_row - row_offset) % 4;
-        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : 19;
+        UBYTE row = (SEGMENT_ROWS + current_row - row_offset) % SEGMENT_ROWS;
+        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : (PLATFORM_COLUMNS - 1);
         
         for (BYTE col = end_col; col >= 0; col--)
         {
@@ -268,7 +236,7 @@ void find_prev_valid_enemy_position_in_code(UBYTE enemy_index, UBYTE *pos_value,
                 {
                     // Found a valid position with the same odd bit
                     UBYTE anchor = (UBYTE)col / 2;
-                    *pos_value = 1 + row * 10 + anchor;
+                    *pos_value = 1 + row * ENEMY_ANCHORS_PER_ROW + anchor;
                     // *odd_bit and *dir_bit remain unchanged
                     return;
                 }
@@ -287,23 +255,13 @@ void find_prev_valid_enemy_position_in_code(UBYTE enemy_index, UBYTE *pos_value,
 // Remove enemies above a deleted platform
 void remove_enemies_above_deleted_platform(UBYTE x, UBYTE y) BANKED
 {
-    // Find the corresponding enemy row for this platform
-    // Platforms are at rows 13, 15, 17, 19, and enemies are at rows 12, 14, 16, 18
-    UBYTE enemy_row = 255;
-
-    if (y == 13)
-        enemy_row = 12;
-    else if (y == 15)
-        enemy_row = 14;
-    else if (y == 17)
-        enemy_row = 16;
-    else if (y == 19)
-        enemy_row = 18;
-
     // If this isn't a platform row that would affect enemies, exit
-    if (enemy_row == 255)
+    if (!IS_PLATFORM_ROW(y))
         return;
 
+    // The enemy row is the top row of the same segment
+    UBYTE enemy_row = ENEMY_ROWS[SEGMENT_ROW_OF(y)];
+
     // Check if there's an enemy actor directly above this platform
     if (has_enemy_actor_at_position(x, enemy_row))
     {
@@ -326,9 +284,9 @@ UBYTE get_valid_enemy_pos41(UBYTE enemy_index, UBYTE current_value) BANKED
         return 0; // No enemy is always valid
 
     // Convert POS41 value to row and column
-    UBYTE v = current_value - 1; // 0-39
-    UBYTE row = v / 10;          // 0-3
-    UBYTE anchor = v % 10;       // 0-9
+    UBYTE v = current_value - 1;                // 0 to ENEMY_POS_MAX - 1
+    UBYTE row = v / ENEMY_ANCHORS_PER_ROW;       // Segment row
+    UBYTE anchor = v % ENEMY_ANCHORS_PER_ROW;
 
     // Get the odd bit for this enemy
     UBYTE odd_bit = (current_level_code.enemy_directions >> enemy_index) & 1;
@@ -337,7 +295,7 @@ UBYTE get_valid_enemy_pos41(UBYTE enemy_index, UBYTE current_value) BANKED
     UBYTE col = anchor * 2 + odd_bit;
 
     // Check if this position is valid
-    if (row < 4 && col < 20 && valid_enemy_positions[row][col])
+    if (row < SEGMENT_ROWS && col < PLATFORM_COLUMNS && valid_enemy_positions[row][col])
         return current_value;
 
     // If not valid, find next valid position
@@ -1,16 +1,20 @@
 #pragma bank 254
 
 #include <gbdk/platform.h>
+#include <string.h>
 #include "vm.h"
 #include "meta_tiles.h"
 #include "code_level_core.h"
 #include "code_platform_system.h"
+#include "code_platform_system_ext.h"
 #include "code_player_system.h"
 #include "code_enemy_system.h"
 #include "tile_utils.h"
 #include "paint.h"
 #include "paint_entity.h"
 #include "code_persistence.h"
+#include "cpu_meter.h"
+#include "cpu_turbo.h"
 
 // External data declarations for cross-bank access
 extern const UBYTE PATTERN_TILE_MAP[];
@@ -40,36 +44,27 @@ level_code_t previous_level_code;
 UBYTE level_code_initialized = 0;
 
 // Cache for encoded values to avoid recalculation (now 7 values for enemy data)
-UBYTE previous_encoded_enemy_data[7];
-UBYTE current_encoded_enemy_data[7];
+UBYTE previous_encoded_enemy_data[LEVEL_CODE_ENEMY_CHARS];
+UBYTE current_encoded_enemy_data[LEVEL_CODE_ENEMY_CHARS];
 
-// Bitmask to track which display positions need updating (24 bits max)
-UWORD display_update_mask_low = 0;  // Bits 0-15
-UBYTE display_update_mask_high = 0; // Bits 16-23
+// Bitmask to track which display positions need updating (one bit per character)
+UBYTE display_update_mask[LEVEL_CODE_MASK_BYTES];
 
 // Mark a display position for update
 void mark_display_position_for_update(UBYTE position) BANKED
 {
-    if (position < 16)
+    if (position < LEVEL_CODE_CHARS_TOTAL)
     {
-        display_update_mask_low |= (1 << position);
-    }
-    else if (position < 24)
-    {
-        display_update_mask_high |= (1 << (position - 16));
+        BLOCK_MASK_SET(display_update_mask, position);
     }
 }
 
 // Check if a display position needs updating
 UBYTE display_position_needs_update(UBYTE position) BANKED
 {
-    if (position < 16)
-    {
-        return (display_update_mask_low & (1 << position)) != 0;
-    }
-    else if (position < 24)
+    if (position < LEVEL_CODE_CHARS_TOTAL)
     {
-        return (display_update_mask_high & (1 << (position - 16))) != 0;
+        return BLOCK_MASK_TEST(display_update_mask, position) != 0;
     }
     return 0;
 }
@@ -77,8 +72,7 @@ UBYTE display_position_needs_update(UBYTE position) BANKED
 // Clear all update flags
 void clear_display_update_flags(void) BANKED
 {
-    display_update_mask_low = 0;
-    display_update_mask_high = 0;
+    memset(display_update_mask, 0, sizeof(display_update_mask));
 }
 
 // Calculate display position for a given character index
@@ -92,8 +86,8 @@ void get_display_position(UBYTE char_index, UBYTE *x, UBYTE *y) BANKED
     // Row 1: 0000 0000 0000 (characters 12-23)
     // Display format: "0000 0000 0000" per row
 
-    UBYTE row = char_index / 12; // 12 characters per row
-    UBYTE col = char_index % 12; // Position within row
+    UBYTE row = char_index / LEVEL_CODE_CHARS_PER_ROW; // 12 characters per row
+    UBYTE col = char_index % LEVEL_CODE_CHARS_PER_ROW; // Position within row
 
     // Calculate column position with spaces between blocks
     UBYTE block = col / 4;        // Which block (0, 1, or 2)
@@ -130,7 +124,7 @@ void detect_level_code_changes(void) BANKED
         current_encoded_enemy_data[6] = encode_enemy_directions(); // Character 23
 
         // Copy to previous cache
-        for (UBYTE i = 0; i < 7; i++)
+        for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
         {
             previous_encoded_enemy_data[i] = current_encoded_enemy_data[i];
         }
@@ -158,16 +152,16 @@ void detect_level_code_changes(void) BANKED
         current_encoded_enemy_data[6] = encode_enemy_directions(); // Character 23
 
         // Compare with previous encoded values (positions 17-23)
-        for (UBYTE i = 0; i < 7; i++)
+        for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
         {
             if (current_encoded_enemy_data[i] != previous_encoded_enemy_data[i])
             {
-                mark_display_position_for_update(17 + i); // Positions 17-23
+                mark_display_position_for_update(LEVEL_CODE_ENEMY_INDEX + i); // Positions 17-23
             }
         }
 
         // Update previous cache
-        for (UBYTE i = 0; i < 7; i++)
+        for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
         {
             previous_encoded_enemy_data[i] = current_encoded_enemy_data[i];
         }
@@ -209,7 +203,7 @@ void init_level_code(void) BANKED
 // Unified update function that coordinates all subsystems
 void update_complete_level_code(void) BANKED
 {
-    extract_platform_data();
+    extract_platform_data_ext();
     // extract_enemy_data(); // No longer needed - enemy data is managed directly in level code
     extract_player_data();
 }
@@ -217,19 +211,19 @@ void update_complete_level_code(void) BANKED
 // Update player actor position based on current level code
 void update_player_actor_position(void) BANKED
 {
-    // Convert column position to tile coordinates (add 2 for offset)
-    UBYTE player_x = current_level_code.player_column + 2;
+    // Convert column position to tile coordinates
+    UBYTE player_x = current_level_code.player_column + PLATFORM_X_MIN;
     
-    // For edit mode: Place the player marker tile on row 11 at the correct column
+    // For edit mode: Place the player marker tile on PLAYER_ROW at the correct column
     // This ensures the editor shows the player position correctly
-    replace_meta_tile(player_x, 11, TILE_PLAYER, 1);
+    replace_meta_tile(player_x, PLAYER_ROW, TILE_PLAYER, 1);
     
     // For gameplay: Move the player actor to the top (row 0) at the correct column
     // This ensures the player starts at the right position when playing
     move_player_to_column(player_x, 0);
     
     // Position the exit sprite relative to the player marker
-    position_exit_for_player(player_x, 11);
+    position_exit_for_player(player_x, PLAYER_ROW);
     
     // Restore all enemy actors from level code data with correct positions and directions
     restore_enemy_actors_from_level_code();
@@ -242,6 +236,7 @@ void update_player_actor_position(void) BANKED
 // Selective level code display - prevents flicker by only updating changed chars
 void display_selective_level_code(void) BANKED
 {
+    CPU_METER_BEGIN(CPU_METER_STAGE_LEVEL_CODE);
     update_complete_level_code();
     detect_level_code_changes();
 
@@ -259,9 +254,9 @@ void display_selective_level_code(void) BANKED
     }
 
     // Display player column (position 16)
-    if (display_position_needs_update(16))
+    if (display_position_needs_update(LEVEL_CODE_PLAYER_INDEX))
     {
-        get_display_position(16, &display_x, &display_y);
+        get_display_position(LEVEL_CODE_PLAYER_INDEX, &display_x, &display_y);
         display_char_at_position(current_level_code.player_column, display_x, display_y);
     }
 
@@ -276,9 +271,9 @@ void display_selective_level_code(void) BANKED
         encode_enemy_directions()  // Position 23: Direction mask (BASE32)
     };
 
-    for (UBYTE i = 0; i < 7; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
     {
-        UBYTE pos = 17 + i; // Positions 17-23
+        UBYTE pos = LEVEL_CODE_ENEMY_INDEX + i; // Positions 17-23
         if (display_position_needs_update(pos))
         {
             get_display_position(pos, &display_x, &display_y);
@@ -289,11 +284,13 @@ void display_selective_level_code(void) BANKED
 
     // Clear update flags after updating
     clear_display_update_flags();
+    CPU_METER_END(CPU_METER_STAGE_LEVEL_CODE);
 }
 
 // Fast selective update that doesn't re-extract all data
 void display_selective_level_code_fast(void) BANKED
 {
+    CPU_METER_BEGIN(CPU_METER_STAGE_LEVEL_CODE);
     // DON'T call update_complete_level_code() - assume data is already correct
     detect_level_code_changes();
 
@@ -311,9 +308,9 @@ void display_selective_level_code_fast(void) BANKED
     }
 
     // Display player column (position 16)
-    if (display_position_needs_update(16))
+    if (display_position_needs_update(LEVEL_CODE_PLAYER_INDEX))
     {
-        get_display_position(16, &display_x, &display_y);
+        get_display_position(LEVEL_CODE_PLAYER_INDEX, &display_x, &display_y);
         // Pass the numeric value directly to display_char_at_position
         display_char_at_position(current_level_code.player_column, display_x, display_y);
     }
@@ -329,9 +326,9 @@ void display_selective_level_code_fast(void) BANKED
         encode_enemy_directions()  // Position 23: Direction mask (BASE32)
     };
 
-    for (UBYTE i = 0; i < 7; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
     {
-        UBYTE pos = 17 + i; // Positions 17-23
+        UBYTE pos = LEVEL_CODE_ENEMY_INDEX + i; // Positions 17-23
         if (display_position_needs_update(pos))
         {
             get_display_position(pos, &display_x, &display_y);
@@ -342,11 +339,13 @@ void display_selective_level_code_fast(void) BANKED
 
     // Clear update flags after updating
     clear_display_update_flags();
+    CPU_METER_END(CPU_METER_STAGE_LEVEL_CODE);
 }
 
 // Force a complete redraw (useful for initialization)
 void force_complete_level_code_display(void) BANKED
 {
+    CPU_METER_BEGIN(CPU_METER_STAGE_LEVEL_CODE);
     update_complete_level_code();
     clear_level_code_display();
 
@@ -361,7 +360,7 @@ void force_complete_level_code_display(void) BANKED
     }
 
     // Display player column (position 16)
-    get_display_position(16, &display_x, &display_y);
+    get_display_position(LEVEL_CODE_PLAYER_INDEX, &display_x, &display_y);
     // Pass the numeric value directly to display_char_at_position
     display_char_at_position(current_level_code.player_column, display_x, display_y);
 
@@ -376,9 +375,9 @@ void force_complete_level_code_display(void) BANKED
         encode_enemy_directions()  // Position 23: Direction mask (BASE32)
     };
 
-    for (UBYTE i = 0; i < 7; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
     {
-        UBYTE pos = 17 + i; // Positions 17-23
+        UBYTE pos = LEVEL_CODE_ENEMY_INDEX + i; // Positions 17-23
         get_display_position(pos, &display_x, &display_y);
         UBYTE enemy_char = get_enemy_display_char(enemy_data[i], pos);
         display_char_at_position(enemy_char, display_x, display_y);
@@ -388,6 +387,7 @@ void force_complete_level_code_display(void) BANKED
     previous_level_code = current_level_code;
     level_code_initialized = 1;
     clear_display_update_flags();
+    CPU_METER_END(CPU_METER_STAGE_LEVEL_CODE);
 }
 
 // Main level code display function
@@ -420,14 +420,14 @@ UBYTE get_extended_display_char(UBYTE value) BANKED
 UBYTE get_enemy_display_char(UBYTE value, UBYTE char_position) BANKED
 {
     // For enemy position characters (17-21), use POS41 system (0-40)
-    if (char_position >= 17 && char_position <= 21)
+    if (char_position >= LEVEL_CODE_ENEMY_INDEX && char_position < LEVEL_CODE_ODD_MASK_INDEX)
     {
         // Validate POS41 range
-        if (value > 40)
+        if (value >= POS41_VALUE_COUNT)
             value = 0; // Safety check
     }
     // For mask characters (22-23), use BASE32 system (0-31)
-    else if (char_position == 22 || char_position == 23)
+    else if (char_position == LEVEL_CODE_ODD_MASK_INDEX || char_position == LEVEL_CODE_DIRECTION_INDEX)
     {
         // Validate BASE32 range
         if (value > 31)
@@ -438,115 +438,31 @@ UBYTE get_enemy_display_char(UBYTE value, UBYTE char_position) BANKED
 }
 
 // Helper function to convert POS41 value directly to tile ID
+// Values 0-9 are '0'-'9', 10-35 'A'-'Z' and 36-40 '!', '@', '#', '$', '%',
+// laid out consecutively from CHAR_TILE_BASE (see level_tiles.h)
 UBYTE pos41_value_to_tile_id(UBYTE value) BANKED
 {
-    // Use the same mapping logic as display_char_at_position
-    if (value > 40)
-        return 48; // Default to '0' tile
+    if (value >= POS41_VALUE_COUNT)
+        return CHAR_TILE_BASE; // Default to '0' tile
 
-    // Values 0-9 map to tiles 48-57
-    if (value < 10)
-    {
-        return 48 + value;
-    }
-    // Values 10-35 map to tiles 58-83 (A-Z)
-    else if (value < 36)
-    {
-        return 58 + (value - 10);
-    }
-    // Special values 36-40 map to tiles 84-88 (!, @, #, $, %)
-    else if (value == 36)
-    {
-        return 84;
-    }
-    else if (value == 37)
-    {
-        return 85;
-    }
-    else if (value == 38)
-    {
-        return 86;
-    }
-    else if (value == 39)
-    {
-        return 87;
-    }
-    else if (value == 40)
-    {
-        return 88;
-    }
-
-    return 48; // Default to '0' tile
+    return CHAR_TILE_BASE + value;
 }
 
 // Helper function to convert BASE32 value directly to tile ID
 UBYTE base32_value_to_tile_id(UBYTE value) BANKED
 {
     // BASE32 uses the same mapping for 0-31 as POS41 does for 0-31
-    if (value > 31)
-        return 48; // Default to '0' tile
+    if (value >= BASE32_VALUE_COUNT)
+        return CHAR_TILE_BASE; // Default to '0' tile
 
-    // Values 0-9 map to tiles 48-57
-    if (value < 10)
-    {
-        return 48 + value;
-    }
-    // Values 10-31 map to tiles 58-79 (first 22 characters of A-Z)
-    else if (value < 32)
-    {
-        return 58 + (value - 10);
-    }
-
-    return 48; // Default to '0' tile
+    return CHAR_TILE_BASE + value;
 }
 
 void display_char_at_position(UBYTE value, UBYTE x, UBYTE y) BANKED
 {
-    // Direct mapping from value to metatile ID
-    UBYTE tile_index;
-
-    // Values 0-9 map to tiles 48-57
-    if (value < 10)
-    {
-        tile_index = 48 + value;
-    }
-    // Values 10-35 map to tiles 58-83 (A-Z)
-    else if (value < 36)
-    {
-        tile_index = 58 + (value - 10);
-    }
-    // Special values 36-40 map to tiles 84-88 (!, @, #, $, %)
-    else if (value == 36)
-    {
-        tile_index = 84;
-    }
-    else if (value == 37)
-    {
-        tile_index = 85;
-    }
-    else if (value == 38)
-    {
-        tile_index = 86;
-    }
-    else if (value == 39)
-    {
-        tile_index = 87;
-    }
-    else if (value == 40)
-    {
-        tile_index = 88;
-    }
-    else if (value <= 48) // Extended range support
-    {
-        // For extended values, we'll still map them to visible tiles
-        // This keeps debug functionality
-        tile_index = 89 + (value - 41); // Use additional tiles if available
-    }
-    else
-    {
-        // Default fallback
-        tile_index = 48; // Default to '0' tile
-    }
+    // Direct mapping from value to metatile ID; values past POS41 (41-48)
+    // still map to visible tiles to keep debug functionality
+    UBYTE tile_index = (value <= CHAR_VALUE_EXTENDED_MAX) ? (CHAR_TILE_BASE + value) : CHAR_TILE_BASE;
 
     replace_meta_tile(x, y, tile_index, 1);
 }
@@ -573,11 +489,11 @@ void clear_level_code_display(void) BANKED
 // UTILITY FUNCTIONS
 // ============================================================================
 
-// Convert display position (x,y) to character index (0-23)
+// Convert display position (x,y) to character index (0 to LEVEL_CODE_CHARS_TOTAL - 1)
 UBYTE get_char_index_from_display_position(UBYTE x, UBYTE y) BANKED
 {
     // Check if position is within the level code display area
-    if (x < LEVEL_CODE_START_X || y < LEVEL_CODE_START_Y || y >= LEVEL_CODE_START_Y + 2)
+    if (x < LEVEL_CODE_START_X || y < LEVEL_CODE_START_Y || y >= LEVEL_CODE_START_Y + LEVEL_CODE_DISPLAY_ROWS)
     {
         return 255; // Invalid position
     }
@@ -619,7 +535,7 @@ UBYTE get_char_index_from_display_position(UBYTE x, UBYTE y) BANKED
     }
 
     // Calculate final character index
-    UBYTE char_index = rel_y * 12 + block * 4 + pos_in_block;
+    UBYTE char_index = rel_y * LEVEL_CODE_CHARS_PER_ROW + block * 4 + pos_in_block;
 
     return (char_index < LEVEL_CODE_CHARS_TOTAL) ? char_index : 255;
 }
@@ -631,7 +547,7 @@ UBYTE get_char_index_from_display_position(UBYTE x, UBYTE y) BANKED
 // Handle when a level code character is edited by the user
 void handle_level_code_character_edit(UBYTE char_index, UBYTE new_value) BANKED
 {
-    if (char_index >= 17 && char_index <= 23)
+    if (char_index >= LEVEL_CODE_ENEMY_INDEX && char_index <= LEVEL_CODE_DIRECTION_INDEX)
     {
         // Enemy data characters - route to enemy system handler
         handle_enemy_data_edit(char_index, new_value);
@@ -640,10 +556,10 @@ void handle_level_code_character_edit(UBYTE char_index, UBYTE new_value) BANKED
         mark_display_position_for_update(char_index);
         display_selective_level_code_fast();
     }
-    else if (char_index < 16)
+    else if (char_index < TOTAL_BLOCKS)
     {
         // Platform pattern characters (0-15)
-        if (new_value <= 34) // Valid platform pattern range
+        if (new_value < PLATFORM_PATTERN_COUNT) // Valid platform pattern range
         {
             current_level_code.platform_patterns[char_index] = new_value;
 
@@ -655,10 +571,10 @@ void handle_level_code_character_edit(UBYTE char_index, UBYTE new_value) BANKED
             display_selective_level_code_fast();
         }
     }
-    else if (char_index == 16)
+    else if (char_index == LEVEL_CODE_PLAYER_INDEX)
     {
         // Player position character
-        if (new_value <= 40) // Valid player position range
+        if (new_value < PLATFORM_COLUMNS) // Valid player position range
         {
             current_level_code.player_column = new_value;
 
@@ -700,24 +616,24 @@ void process_level_code_external_changes(void) BANKED
         if (level_code_display_changed[i])
         {
             // Apply the change to the appropriate system
-            if (i >= 17 && i <= 23)
+            if (i >= LEVEL_CODE_ENEMY_INDEX && i <= LEVEL_CODE_DIRECTION_INDEX)
             {
                 // Enemy data characters
                 handle_enemy_data_edit(i, level_code_display_values[i]);
             }
-            else if (i < 16)
+            else if (i < TOTAL_BLOCKS)
             {
                 // Platform pattern characters
-                if (level_code_display_values[i] <= 34)
+                if (level_code_display_values[i] < PLATFORM_PATTERN_COUNT)
                 {
                     current_level_code.platform_patterns[i] = level_code_display_values[i];
                     reconstruct_tilemap_from_level_code();
                 }
             }
-            else if (i == 16)
+            else if (i == LEVEL_CODE_PLAYER_INDEX)
             {
                 // Player position character
-                if (level_code_display_values[i] <= 40)
+                if (level_code_display_values[i] < PLATFORM_COLUMNS)
                 {
                     current_level_code.player_column = level_code_display_values[i];
                     update_player_actor_position();
@@ -737,24 +653,24 @@ void process_level_code_external_changes(void) BANKED
 void sync_level_code_display_values(void) BANKED
 {
     // Sync enemy position characters (17-21)
-    level_code_display_values[17] = encode_enemy_positions();
-    level_code_display_values[18] = encode_enemy_details_1();
-    level_code_display_values[19] = encode_enemy_details_2();
-    level_code_display_values[20] = encode_enemy_position_4();
-    level_code_display_values[21] = encode_enemy_position_5();
+    level_code_display_values[LEVEL_CODE_ENEMY_INDEX + 0] = encode_enemy_positions();
+    level_code_display_values[LEVEL_CODE_ENEMY_INDEX + 1] = encode_enemy_details_1();
+    level_code_display_values[LEVEL_CODE_ENEMY_INDEX + 2] = encode_enemy_details_2();
+    level_code_display_values[LEVEL_CODE_ENEMY_INDEX + 3] = encode_enemy_position_4();
+    level_code_display_values[LEVEL_CODE_ENEMY_INDEX + 4] = encode_enemy_position_5();
 
     // Sync enemy mask characters (22-23)
-    level_code_display_values[22] = encode_odd_mask_value();
-    level_code_display_values[23] = encode_enemy_directions();
+    level_code_display_values[LEVEL_CODE_ODD_MASK_INDEX] = encode_odd_mask_value();
+    level_code_display_values[LEVEL_CODE_DIRECTION_INDEX] = encode_enemy_directions();
 
     // Sync platform patterns (0-15)
-    for (UBYTE i = 0; i < 16; i++)
+    for (UBYTE i = 0; i < TOTAL_BLOCKS; i++)
     {
         level_code_display_values[i] = current_level_code.platform_patterns[i];
     }
 
     // Sync player position (16)
-    level_code_display_values[16] = current_level_code.player_column;
+    level_code_display_values[LEVEL_CODE_PLAYER_INDEX] = current_level_code.player_column;
 }
 
 // ============================================================================
@@ -765,11 +681,11 @@ void sync_level_code_display_values(void) BANKED
 // Enemy 0 position is at character 17, enemy 1 at 18, etc.
 void set_enemy_position_direct(UBYTE enemy_index, UBYTE position) BANKED
 {
-    if (enemy_index > 4)
+    if (enemy_index >= LEVEL_CODE_ENEMY_POSITIONS)
         return; // Invalid enemy index
 
     // Calculate the character index for this enemy's position
-    UBYTE char_index = 17 + enemy_index;
+    UBYTE char_index = LEVEL_CODE_ENEMY_INDEX + enemy_index;
 
     // Set the enemy position directly
     handle_enemy_data_edit(char_index, position);
@@ -783,7 +699,7 @@ void set_all_enemies_direction(UBYTE direction) BANKED
         return; // Invalid direction
 
     // Set the direction mask directly
-    handle_enemy_data_edit(23, direction);
+    handle_enemy_data_edit(LEVEL_CODE_DIRECTION_INDEX, direction);
 }
 
 // ============================================================================
@@ -835,11 +751,11 @@ void display_enemy_char_at_position(UBYTE value, UBYTE char_position, UBYTE x, U
 {
     UBYTE tile_id;
 
-    if (char_position >= 17 && char_position <= 21) // POS41 characters
+    if (char_position >= LEVEL_CODE_ENEMY_INDEX && char_position < LEVEL_CODE_ODD_MASK_INDEX) // POS41 characters
     {
         tile_id = pos41_value_to_tile_id(value);
     }
-    else if (char_position == 22 || char_position == 23) // BASE32 characters
+    else if (char_position == LEVEL_CODE_ODD_MASK_INDEX || char_position == LEVEL_CODE_DIRECTION_INDEX) // BASE32 characters
     {
         tile_id = base32_value_to_tile_id(value);
     }
@@ -856,6 +772,7 @@ void init_tilemap_editor_from_memory(void) BANKED
 {
     // This function should be called when the tilemap editor loads
     // It restores the level state from saved variables and ensures proper positioning
+    cpu_turbo_begin();
     
     // Load level data from variables (this only loads platform patterns)
     load_level_code_from_variables();
@@ -873,6 +790,7 @@ void init_tilemap_editor_from_memory(void) BANKED
     
     // Force display update to show current state
     force_complete_level_code_display();
+    cpu_turbo_end();
 }
 
 // VM function to initialize tilemap editor from memory
@@ -0,0 +1,141 @@
+#pragma bank 255
+
+#include <gbdk/platform.h>
+#include "vm.h"
+#include "job.h"
+#include "code_level_jobs.h"
+#include "code_level_core.h"
+#include "code_persistence.h"
+#include "code_platform_system.h"
+#include "code_platform_system_ext.h"
+#include "code_player_system.h"
+#include "meta_tiles.h"
+#include "cpu_turbo.h"
+
+BANKREF(CODE_LEVEL_JOBS)
+
+// Set while the rebuild should also resync the player data (editor init)
+static UBYTE level_job_sync_player;
+
+// ============================================================================
+// JOB STEP HANDLER
+// ============================================================================
+
+// One block per step, so a full rebuild is spread over TOTAL_BLOCKS * 2 + 2 steps.
+// Display updates stay suppressed until the final steps, matching restore_level_from_memory()
+UBYTE level_rebuild_job_step(UBYTE step) OLDCALL BANKED
+{
+    if (step < LEVEL_JOB_STEP_VALIDATE)
+    {
+        if (step == LEVEL_JOB_STEP_PAINT)
+        {
+            set_suppress_display_updates_ext(1);
+            // tiles land in SRAM only; the whole screen is redrawn once at the end
+            meta_tiles_defer_commit(TRUE);
+            // held across frames until the last step; a scene change releases it
+            cpu_turbo_hold(CPU_TURBO_HOLD_JOB, TRUE);
+        }
+        apply_pattern_with_brush_logic_ext(step, current_level_code.platform_patterns[step]);
+        return FALSE;
+    }
+    if (step < LEVEL_JOB_STEP_PLAYER)
+    {
+        update_single_block_code(step - LEVEL_JOB_STEP_VALIDATE);
+        return FALSE;
+    }
+    if (step == LEVEL_JOB_STEP_PLAYER)
+    {
+        set_suppress_display_updates_ext(0);
+        meta_tiles_defer_commit(FALSE);
+        if (level_job_sync_player) extract_player_data();
+        update_player_actor_position();
+        return FALSE;
+    }
+    force_complete_level_code_display();
+    cpu_turbo_hold(CPU_TURBO_HOLD_JOB, FALSE);
+    return TRUE;
+}
+
+// Called when jobs_init() drops an unfinished rebuild. The scene load that
+// follows resets the deferred commit and the turbo hold, but not the editor's
+// display suppression, so clear it here or painting stops updating the screen
+UBYTE level_rebuild_job_cancel(UBYTE step) OLDCALL BANKED
+{
+    if (step > LEVEL_JOB_STEP_PAINT && step <= LEVEL_JOB_STEP_PLAYER)
+        set_suppress_display_updates_ext(0);
+    return TRUE;
+}
+
+// ============================================================================
+// JOB START FUNCTIONS
+// ============================================================================
+
+UBYTE start_level_rebuild_job(void) BANKED
+{
+    UBYTE id = job_start(BANK(CODE_LEVEL_JOBS), (void *)level_rebuild_job_step);
+    job_set_cancel(id, BANK(CODE_LEVEL_JOBS), (void *)level_rebuild_job_cancel);
+    if (id == JOB_NONE)
+    {
+        // No free slot: fall back to the blocking rebuild
+        restore_level_from_memory();
+        if (level_job_sync_player)
+        {
+            extract_player_data();
+            update_player_actor_position();
+            force_complete_level_code_display();
+        }
+    }
+    return id;
+}
+
+UBYTE start_restore_level_job(void) BANKED
+{
+    // Nothing to rebuild: init_default_level_code handles the full setup
+    if (!has_level_data_in_memory())
+    {
+        restore_level_from_memory();
+        return JOB_NONE;
+    }
+    level_job_sync_player = 0;
+    return start_level_rebuild_job();
+}
+
+UBYTE start_init_tilemap_editor_job(void) BANKED
+{
+    // Load level data from variables (this only loads platform patterns)
+    load_level_code_from_variables();
+    if (!has_level_data_in_memory())
+    {
+        init_tilemap_editor_from_memory();
+        return JOB_NONE;
+    }
+    level_job_sync_player = 1;
+    return start_level_rebuild_job();
+}
+
+UBYTE start_load_predefined_level_job(UBYTE level_index) BANKED
+{
+    if (!decode_predefined_level(level_index)) return JOB_NONE; // Invalid level
+    level_job_sync_player = 0;
+    return start_level_rebuild_job();
+}
+
+// ============================================================================
+// VM WRAPPER FUNCTIONS
+// ============================================================================
+
+void vm_restore_level_from_memory_job(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    *(UWORD *)VM_REF_TO_PTR(FN_ARG0) = start_restore_level_job();
+}
+
+void vm_init_tilemap_editor_from_memory_job(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    *(UWORD *)VM_REF_TO_PTR(FN_ARG0) = start_init_tilemap_editor_job();
+}
+
+void vm_load_predefined_level_job(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    UBYTE level_index = *(UBYTE *)VM_REF_TO_PTR(FN_ARG0);
+    *(UWORD *)VM_REF_TO_PTR(FN_ARG0) = start_load_predefined_level_job(level_index);
+}
@@ -12,6 +12,12 @@
 #include "tile_utils.h"
 #include "paint.h"
 #include "code_enemy_system_validation.h"
+#include "enemy_position_manager.h"
+#include "cpu_turbo.h"
+#ifdef BATTERYLESS
+#include "system.h"
+#include "flash_journal.h"
+#endif
 
 // ============================================================================
 // FORWARD DECLARATIONS
@@ -221,10 +227,24 @@ void save_level_code_to_sram(void) BANKED
     ENABLE_RAM;
     UBYTE *sram_ptr = (UBYTE *)(0xA000 + SRAM_LEVEL_CODE_OFFSET);
     UBYTE *data_ptr = (UBYTE *)&sram_data;
+#ifdef BATTERYLESS
+    UBYTE changed = FALSE;
+#endif
     for (UBYTE i = 0; i < sizeof(sram_level_code_t); i++)
     {
-        sram_ptr[i] = data_ptr[i];
+        if (sram_ptr[i] != data_ptr[i])
+        {
+            sram_ptr[i] = data_ptr[i];
+#ifdef BATTERYLESS
+            changed = TRUE;
+#endif
+        }
     }
+#ifdef BATTERYLESS
+    // Append the record to the flash journal instead of rewriting every SRAM mirror
+    if (changed)
+        flash_journal_write(_current_ram_bank, sram_ptr, sizeof(sram_level_code_t));
+#endif
     DISABLE_RAM;
 }
 
@@ -314,7 +334,7 @@ void update_level_code_from_character_edit(UBYTE char_index, UBYTE new_value) BA
         // Finally, update the display to show the correct final state
         display_selective_level_code_fast();
     }
-    else if (char_index == 16)
+    else if (char_index == LEVEL_CODE_PLAYER_INDEX)
     {
         // Player column position
         if (is_valid_player_position(new_value))
@@ -322,8 +342,8 @@ void update_level_code_from_character_edit(UBYTE char_index, UBYTE new_value) BA
             current_level_code.player_column = new_value;
 
             // Update player visual position
-            UBYTE player_x = new_value + 2;
-            UBYTE player_y = 11;
+            UBYTE player_x = new_value + PLATFORM_X_MIN;
+            UBYTE player_y = PLAYER_ROW;
             clear_existing_player_on_row_11();
             replace_meta_tile(player_x, player_y, TILE_PLAYER, 1);
             // Move player actor to new position
@@ -333,7 +353,7 @@ void update_level_code_from_character_edit(UBYTE char_index, UBYTE new_value) BA
             position_exit_for_player(player_x, player_y);
         }
     }
-    else if (char_index >= 17 && char_index <= 23)
+    else if (char_index >= LEVEL_CODE_ENEMY_INDEX && char_index <= LEVEL_CODE_DIRECTION_INDEX)
     {
         // Enemy data characters - use the enemy system to handle the edit
         handle_enemy_data_edit(char_index, new_value);
@@ -385,7 +405,7 @@ static void cycle_character_internal(UBYTE x, UBYTE y, BYTE direction) BANKED
                             ? get_next_valid_pattern_for_char(char_index, current_value)
                             : get_previous_valid_pattern_for_char(char_index, current_value);
         }
-        else if (char_index == 16)
+        else if (char_index == LEVEL_CODE_PLAYER_INDEX)
         {
             // Player column: cycle only through valid positions (columns with platforms)
             // First, ensure fresh platform data
@@ -397,11 +417,11 @@ static void cycle_character_internal(UBYTE x, UBYTE y, BYTE direction) BANKED
                             ? get_next_valid_player_position(current_value)
                             : get_previous_valid_player_position(current_value);
         }
-        else if (char_index >= 17 && char_index <= 21)
+        else if (char_index >= LEVEL_CODE_ENEMY_INDEX && char_index < LEVEL_CODE_ODD_MASK_INDEX)
         {
             // Enemy positions (POS41 system): 0-40 (0 means no enemy)
             // Get the enemy index from the character position (17-21 -> 0-4)
-            UBYTE enemy_index = char_index - 17;
+            UBYTE enemy_index = char_index - LEVEL_CODE_ENEMY_INDEX;
 
             // Update valid enemy positions to ensure we're using current data
             update_valid_enemy_positions_unified();
@@ -429,7 +449,7 @@ static void cycle_character_internal(UBYTE x, UBYTE y, BYTE direction) BANKED
                 // odd_bit and dir_bit remain unchanged during position cycling
             }
         }
-        else if (char_index == 22 || char_index == 23)
+        else if (char_index == LEVEL_CODE_ODD_MASK_INDEX || char_index == LEVEL_CODE_DIRECTION_INDEX)
         {
             // Enemy mask values (BASE32 system): 0-31
             // Use validation to ensure only valid offset combinations are allowed
@@ -535,38 +555,39 @@ void update_display_with_value(UBYTE char_index, UBYTE value, UBYTE x, UBYTE y)
 #define VAR_LEVEL_CODE_CHAR_BASE 50  // Starting variable ID - adjust as needed
 
 // Generate current level code as 24 character values
-void generate_level_code_string(UBYTE level_code_chars[24]) BANKED
+void generate_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED
 {
     // Update current level code data
     update_complete_level_code();
     
-    // Characters 0-15: Platform patterns (values 0-34)
-    for (UBYTE i = 0; i < 16; i++)
+    // Characters 0 to TOTAL_BLOCKS - 1: Platform patterns (values 0 to PLATFORM_PATTERN_COUNT - 1)
+    for (UBYTE i = 0; i < TOTAL_BLOCKS; i++)
     {
         level_code_chars[i] = current_level_code.platform_patterns[i];
     }
     
     // Character 16: Player column position (values 0-40)
-    level_code_chars[16] = current_level_code.player_column;
+    level_code_chars[LEVEL_CODE_PLAYER_INDEX] = current_level_code.player_column;
     
     // Characters 17-23: Enemy data (encoded values)
-    level_code_chars[17] = encode_enemy_positions();   // Enemy 0 position (POS41: 0-40)
-    level_code_chars[18] = encode_enemy_details_1();   // Enemy 1 position (POS41: 0-40)
-    level_code_chars[19] = encode_enemy_details_2();   // Enemy 2 position (POS41: 0-40)
-    level_code_chars[20] = encode_enemy_position_4();  // Enemy 3 position (POS41: 0-40)
-    level_code_chars[21] = encode_enemy_position_5();  // Enemy 4 position (POS41: 0-40)
-    level_code_chars[22] = encode_odd_mask_value();    // Odd column mask (BASE32: 0-31)
-    level_code_chars[23] = encode_enemy_directions();  // Direction mask (BASE32: 0-31)
+    UBYTE *enemy_chars = level_code_chars + LEVEL_CODE_ENEMY_INDEX;
+    enemy_chars[0] = encode_enemy_positions();   // Enemy 0 position (POS41: 0-40)
+    enemy_chars[1] = encode_enemy_details_1();   // Enemy 1 position (POS41: 0-40)
+    enemy_chars[2] = encode_enemy_details_2();   // Enemy 2 position (POS41: 0-40)
+    enemy_chars[3] = encode_enemy_position_4();  // Enemy 3 position (POS41: 0-40)
+    enemy_chars[4] = encode_enemy_position_5();  // Enemy 4 position (POS41: 0-40)
+    level_code_chars[LEVEL_CODE_ODD_MASK_INDEX] = encode_odd_mask_value();    // Odd column mask (BASE32: 0-31)
+    level_code_chars[LEVEL_CODE_DIRECTION_INDEX] = encode_enemy_directions(); // Direction mask (BASE32: 0-31)
 }
 
 // Save current level code as 24 individual character values to variables
 void save_level_code_string_to_variables(void) BANKED
 {
-    UBYTE level_code_chars[24];
+    UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL];
     generate_level_code_string(level_code_chars);
     
     // Store each character value in its own variable
-    for (UBYTE i = 0; i < 24; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         script_memory[VAR_LEVEL_CODE_CHAR_BASE + i] = level_code_chars[i];
     }
@@ -575,10 +596,10 @@ void save_level_code_string_to_variables(void) BANKED
 // Load level code from 24 individual character values in variables
 void load_level_code_string_from_variables(void) BANKED
 {
-    UBYTE level_code_chars[24];
+    UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL];
     
     // Read each character value from its variable
-    for (UBYTE i = 0; i < 24; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         level_code_chars[i] = script_memory[VAR_LEVEL_CODE_CHAR_BASE + i];
     }
@@ -588,24 +609,36 @@ void load_level_code_string_from_variables(void) BANKED
 }
 
 // Apply a 24-character level code to the current game state
-void apply_level_code_string(UBYTE level_code_chars[24]) BANKED
+void apply_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED
+{
+    cpu_turbo_begin();
+    decode_level_code_string(level_code_chars);
+    
+    // Rebuild the level visually
+    reconstruct_tilemap_from_level_code();
+    force_complete_level_code_display();
+    cpu_turbo_end();
+}
+
+// Decode a 24-character level code into current_level_code without touching the tilemap
+void decode_level_code_string(UBYTE level_code_chars[LEVEL_CODE_CHARS_TOTAL]) BANKED
 {
     // Initialize level code structure
     init_level_code();
     
     // Set platform patterns (characters 0-15)
-    for (UBYTE i = 0; i < 16; i++)
+    for (UBYTE i = 0; i < TOTAL_BLOCKS; i++)
     {
-        if (level_code_chars[i] <= 34) // Valid platform pattern range
+        if (level_code_chars[i] < PLATFORM_PATTERN_COUNT) // Valid platform pattern range
         {
             current_level_code.platform_patterns[i] = level_code_chars[i];
         }
     }
     
     // Set player position (character 16)
-    if (level_code_chars[16] <= 40) // Valid player position range
+    if (level_code_chars[LEVEL_CODE_PLAYER_INDEX] < PLATFORM_COLUMNS) // Valid player position range
     {
-        current_level_code.player_column = level_code_chars[16];
+        current_level_code.player_column = level_code_chars[LEVEL_CODE_PLAYER_INDEX];
     }
     
     // Validate player position after setting platforms
@@ -616,15 +649,15 @@ void apply_level_code_string(UBYTE level_code_chars[24]) BANKED
     }
     
     // Apply enemy data (characters 17-23)
-    UBYTE enemy_values[7];
-    for (UBYTE i = 0; i < 7; i++)
+    UBYTE enemy_values[LEVEL_CODE_ENEMY_CHARS];
+    for (UBYTE i = 0; i < LEVEL_CODE_ENEMY_CHARS; i++)
     {
-        enemy_values[i] = level_code_chars[17 + i];
+        enemy_values[i] = level_code_chars[LEVEL_CODE_ENEMY_INDEX + i];
         
         // Validate ranges
-        if (i < 5) // Position characters (17-21)
+        if (i < LEVEL_CODE_ENEMY_POSITIONS) // Position characters (17-21)
         {
-            if (enemy_values[i] > 40) enemy_values[i] = 0; // POS41 range
+            if (enemy_values[i] > ENEMY_POS_MAX) enemy_values[i] = 0; // POS41 range
         }
         else // Mask characters (22-23)
         {
@@ -634,36 +667,148 @@ void apply_level_code_string(UBYTE level_code_chars[24]) BANKED
     
     // Decode and apply enemy data
     decode_enemy_data_from_values(enemy_values);
-    
-    // Rebuild the level visually
-    reconstruct_tilemap_from_level_code();
-    force_complete_level_code_display();
+}
+
+// ============================================================================
+// VARIABLE-LENGTH LEVEL CODE
+// ============================================================================
+
+// Layout (see level_format.h): [segments per row, segment rows] patterns
+// [player column hi, lo] [enemy count] then per enemy [row, column hi, lo, direction].
+// Columns are split into two BASE32 digits so levels wider than one screen fit.
+
+// Generate the variable-length level code, returns the number of characters written
+UBYTE generate_level_code_ext(UBYTE *buf) BANKED
+{
+    update_complete_level_code();
+
+    UBYTE n = 0;
+    buf[n++] = SEGMENTS_PER_ROW;
+    buf[n++] = SEGMENT_ROWS;
+
+    for (UBYTE i = 0; i < TOTAL_BLOCKS; i++)
+    {
+        buf[n++] = current_level_code.platform_patterns[i];
+    }
+
+    buf[n++] = current_level_code.player_column >> 5;
+    buf[n++] = current_level_code.player_column & 0x1F;
+
+    UBYTE count_index = n++;
+    UBYTE count = 0;
+    for (UBYTE i = 0; i < MAX_ENEMIES; i++)
+    {
+        UBYTE col = current_level_code.enemy_positions[i];
+        if (col == 255)
+            continue;
+
+        buf[n++] = current_level_code.enemy_rows[i];
+        buf[n++] = col >> 5;
+        buf[n++] = col & 0x1F;
+        buf[n++] = (current_level_code.enemy_directions >> i) & 1;
+        count++;
+    }
+    buf[count_index] = count;
+
+    return n;
+}
+
+// Decode a variable-length level code into current_level_code
+// Returns 0 if the code was made for a different grid geometry or is truncated
+UBYTE decode_level_code_ext(const UBYTE *buf, UBYTE len) BANKED
+{
+    if (len < LEVEL_CODE_EXT_MIN_CHARS)
+        return 0;
+    if (buf[0] != SEGMENTS_PER_ROW || buf[1] != SEGMENT_ROWS)
+        return 0;
+
+    UBYTE count = buf[LEVEL_CODE_EXT_MIN_CHARS - 1];
+    if (count > MAX_ENEMIES || len < LEVEL_CODE_EXT_MIN_CHARS + count * LEVEL_CODE_EXT_ENEMY_CHARS)
+        return 0;
+
+    init_level_code();
+
+    const UBYTE *p = buf + LEVEL_CODE_EXT_HEADER_CHARS;
+    for (UBYTE i = 0; i < TOTAL_BLOCKS; i++, p++)
+    {
+        if (*p < PLATFORM_PATTERN_COUNT) // Valid platform pattern range
+        {
+            current_level_code.platform_patterns[i] = *p;
+        }
+    }
+
+    UBYTE player_column = (p[0] << 5) | p[1];
+    if (player_column < PLATFORM_COLUMNS)
+    {
+        current_level_code.player_column = player_column;
+    }
+    p += LEVEL_CODE_EXT_PLAYER_CHARS + 1;
+
+    update_valid_player_positions();
+    if (valid_player_count > 0 && !is_valid_player_position(current_level_code.player_column))
+    {
+        current_level_code.player_column = valid_player_columns[0];
+    }
+
+    // Enemies are written straight into the level code, same rules as decode_enemy_position
+    current_level_code.enemy_directions = 0;
+    for (UBYTE i = 0; i < MAX_ENEMIES; i++)
+    {
+        clear_enemy_actor(i);
+        current_level_code.enemy_positions[i] = 255;
+        current_level_code.enemy_rows[i] = 255;
+    }
+
+    for (UBYTE k = 0; k < count; k++, p += LEVEL_CODE_EXT_ENEMY_CHARS)
+    {
+        UBYTE row = p[0];
+        UBYTE col = (p[1] << 5) | p[2];
+        UBYTE dir_bit = p[3] & 1;
+
+        if (row >= SEGMENT_ROWS || col >= PLATFORM_COLUMNS)
+            continue;
+
+        UBYTE tilemap_x = PLATFORM_X_MIN + col;
+        UBYTE tilemap_y = ENEMY_ROW_Y(row);
+        if (has_enemy_at_exact_position_excluding(tilemap_x, tilemap_y, k))
+            continue;
+
+        current_level_code.enemy_positions[k] = col;
+        current_level_code.enemy_rows[k] = row;
+        if (dir_bit)
+        {
+            current_level_code.enemy_directions |= (1 << k);
+        }
+        place_enemy_actor(k, tilemap_x, tilemap_y, dir_bit);
+    }
+
+    return 1;
 }
 
 // Set a specific character in the stored level code
 void set_level_code_character(UBYTE char_index, UBYTE value) BANKED
 {
-    if (char_index >= 24) return; // Invalid index
+    if (char_index >= LEVEL_CODE_CHARS_TOTAL) return; // Invalid index
     
     // Validate value range based on character position
-    if (char_index < 16) // Platform patterns
+    if (char_index < TOTAL_BLOCKS) // Platform patterns
     {
-        if (value > 34) return; // Invalid platform pattern
+        if (value >= PLATFORM_PATTERN_COUNT) return; // Invalid platform pattern
     }
-    else if (char_index == 16) // Player position
+    else if (char_index == LEVEL_CODE_PLAYER_INDEX) // Player position
     {
-        if (value > 40) return; // Invalid player position
+        if (value >= PLATFORM_COLUMNS) return; // Invalid player position
     }
-    else if (char_index >= 17 && char_index <= 21) // Enemy positions
+    else if (char_index >= LEVEL_CODE_ENEMY_INDEX && char_index < LEVEL_CODE_ODD_MASK_INDEX) // Enemy positions
     {
-        if (value > 40) return; // Invalid POS41 value
+        if (value > ENEMY_POS_MAX) return; // Invalid POS41 value
     }
-    else if (char_index >= 22 && char_index <= 23) // Enemy masks
+    else if (char_index >= LEVEL_CODE_ODD_MASK_INDEX && char_index <= LEVEL_CODE_DIRECTION_INDEX) // Enemy masks
     {
         if (value > 31) return; // Invalid BASE32 value
         
         // Additional validation for character 22 (offset mask) - only allow valid combinations
-        if (char_index == 22)
+        if (char_index == LEVEL_CODE_ODD_MASK_INDEX)
         {
             if (!is_valid_offset_mask(value)) return; // Invalid offset combination
         }
@@ -676,7 +821,7 @@ void set_level_code_character(UBYTE char_index, UBYTE value) BANKED
 // Get a specific character from the stored level code
 UBYTE get_level_code_character(UBYTE char_index) BANKED
 {
-    if (char_index >= 24) return 0; // Invalid index
+    if (char_index >= LEVEL_CODE_CHARS_TOTAL) return 0; // Invalid index
     return script_memory[VAR_LEVEL_CODE_CHAR_BASE + char_index];
 }
 
@@ -684,7 +829,7 @@ UBYTE get_level_code_character(UBYTE char_index) BANKED
 UBYTE has_saved_level_code_string(void) BANKED
 {
     // Check if any character variables contain non-zero data
-    for (UBYTE i = 0; i < 24; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         if (script_memory[VAR_LEVEL_CODE_CHAR_BASE + i] != 0)
         {
@@ -697,7 +842,7 @@ UBYTE has_saved_level_code_string(void) BANKED
 // Clear all stored level code data
 void clear_level_code_string(void) BANKED
 {
-    for (UBYTE i = 0; i < 24; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         script_memory[VAR_LEVEL_CODE_CHAR_BASE + i] = 0;
     }
@@ -707,31 +852,28 @@ void clear_level_code_string(void) BANKED
 // SIMPLE MEMORY-BASED RESTORE SYSTEM
 // ============================================================================
 
-// Restore the level from current C memory state
-// This rebuilds the tilemap and display from whatever is currently in memory
-void restore_level_from_memory(void) BANKED
+// Check if memory contains any level data (platform patterns or player position)
+UBYTE has_level_data_in_memory(void) BANKED
 {
-    // Check if memory contains any level data, if not initialize with default
-    UBYTE has_level_data = 0;
-    
     // Check if there are any platform patterns
     for (UBYTE i = 0; i < TOTAL_BLOCKS; i++)
     {
         if (current_level_code.platform_patterns[i] != 0)
         {
-            has_level_data = 1;
-            break;
+            return 1;
         }
     }
     
     // Check if player position is set
-    if (current_level_code.player_column != 0)
-    {
-        has_level_data = 1;
-    }
-    
+    return current_level_code.player_column != 0;
+}
+
+// Restore the level from current C memory state
+// This rebuilds the tilemap and display from whatever is currently in memory
+void restore_level_from_memory(void) BANKED
+{
     // If no level data exists, initialize with default level
-    if (!has_level_data)
+    if (!has_level_data_in_memory())
     {
         init_default_level_code();
         return; // init_default_level_code handles the full setup
@@ -742,8 +884,11 @@ void restore_level_from_memory(void) BANKED
     set_suppress_display_updates_ext(1);
     
     // Rebuild the tilemap from current level code data using the paint system
-    // This ensures platforms get proper end caps and visual styling
+    // This ensures platforms get proper end caps and visual styling.
+    // Tile writes are held back and the screen is redrawn once afterwards
+    meta_tiles_defer_commit(TRUE);
     reconstruct_tilemap_from_level_code();
+    meta_tiles_defer_commit(FALSE);
     
     // Re-enable display updates
     set_suppress_display_updates_ext(0);
@@ -761,39 +906,38 @@ void restore_level_from_memory(void) BANKED
 
 // Structure to hold a pre-defined level code
 typedef struct {
-    UBYTE chars[24];
+    UBYTE chars[LEVEL_CODE_CHARS_TOTAL];
 } predefined_level_t;
 
-// Example predefined levels (you can expand this)
-const predefined_level_t PREDEFINED_LEVELS[] = {
-    // Level 0: Simple starting level
-    {{ 1, 1, 1, 1,  2, 2, 2, 2,  3, 3, 3, 3,  4, 4, 4, 4,  // Platforms 0-15
-       10,                                                    // Player position
-       0, 0, 0, 0, 0,                                        // Enemy positions 17-21
-       0, 0 }},                                              // Enemy masks 22-23
-    
-    // Level 1: More complex level
-    {{ 5, 3, 1, 7,  2, 4, 6, 8,  1, 3, 5, 7,  2, 4, 6, 8,  // Platforms 0-15
-       5,                                                     // Player position
-       15, 25, 35, 0, 0,                                     // Enemy positions 17-21
-       7, 3 }},                                              // Enemy masks 22-23
-};
+// Pre-defined levels, generated from tools/level_format/level_format.json
+const predefined_level_t PREDEFINED_LEVELS[] = PREDEFINED_LEVELS_INIT;
 
-#define NUM_PREDEFINED_LEVELS (sizeof(PREDEFINED_LEVELS) / sizeof(predefined_level_t))
+#define NUM_PREDEFINED_LEVELS PREDEFINED_LEVEL_COUNT
 
 // Load a predefined level by index
 void load_predefined_level(UBYTE level_index) BANKED
 {
-    if (level_index >= NUM_PREDEFINED_LEVELS) return; // Invalid level
+    if (!decode_predefined_level(level_index)) return; // Invalid level
+    
+    // Rebuild the level visually
+    reconstruct_tilemap_from_level_code();
+    force_complete_level_code_display();
+}
+
+// Copy a predefined level to variables and decode it, without rebuilding the tilemap
+UBYTE decode_predefined_level(UBYTE level_index) BANKED
+{
+    if (level_index >= NUM_PREDEFINED_LEVELS) return 0; // Invalid level
     
     // Copy the predefined level to variables
-    for (UBYTE i = 0; i < 24; i++)
+    for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         script_memory[VAR_LEVEL_CODE_CHAR_BASE + i] = PREDEFINED_LEVELS[level_index].chars[i];
     }
     
-    // Apply the level code
-    apply_level_code_string((UBYTE*)PREDEFINED_LEVELS[level_index].chars);
+    // Decode the level code
+    decode_level_code_string((UBYTE*)PREDEFINED_LEVELS[level_index].chars);
+    return 1;
 }
 
 // Get the number of available predefined levels
@@ -861,6 +1005,53 @@ void vm_get_predefined_level_count(SCRIPT_CTX *THIS) BANKED
     *(UWORD *)VM_REF_TO_PTR(FN_ARG0) = get_predefined_level_count();
 }
 
+// Export the variable-length level code into consecutive variables
+// ARG0 = first variable, ARG1 = variable receiving the code length
+void vm_save_level_code_ext(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    INT16 dest = *(INT16 *)VM_REF_TO_PTR(FN_ARG0);
+    INT16 length_var = *(INT16 *)VM_REF_TO_PTR(FN_ARG1);
+    UBYTE buf[LEVEL_CODE_EXT_MAX_CHARS];
+
+    UBYTE len = generate_level_code_ext(buf);
+    for (UBYTE i = 0; i < len; i++)
+    {
+        script_memory[dest + i] = buf[i];
+    }
+    script_memory[length_var] = len;
+}
+
+// Import a variable-length level code from consecutive variables and rebuild the level
+// ARG0 = first variable, ARG1 = variable receiving 1 on success, 0 on mismatch
+void vm_load_level_code_ext(SCRIPT_CTX *THIS) OLDCALL BANKED
+{
+    INT16 src = *(INT16 *)VM_REF_TO_PTR(FN_ARG0);
+    INT16 result_var = *(INT16 *)VM_REF_TO_PTR(FN_ARG1);
+    UBYTE buf[LEVEL_CODE_EXT_MAX_CHARS];
+
+    // Enemy count sits right after the fixed part, so the length is known once it is read
+    UBYTE count = (UBYTE)script_memory[src + LEVEL_CODE_EXT_MIN_CHARS - 1];
+    if (count > MAX_ENEMIES)
+    {
+        script_memory[result_var] = 0;
+        return;
+    }
+
+    UBYTE len = LEVEL_CODE_EXT_MIN_CHARS + count * LEVEL_CODE_EXT_ENEMY_CHARS;
+    for (UBYTE i = 0; i < len; i++)
+    {
+        buf[i] = (UBYTE)script_memory[src + i];
+    }
+
+    UBYTE ok = decode_level_code_ext(buf, len);
+    if (ok)
+    {
+        reconstruct_tilemap_from_level_code();
+        force_complete_level_code_display();
+    }
+    script_memory[result_var] = ok;
+}
+
 // Restore level from C memory (simple scene reload)
 void vm_restore_level_from_memory(SCRIPT_CTX *THIS) BANKED
 {
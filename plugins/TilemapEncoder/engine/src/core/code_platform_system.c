@@ -9,6 +9,7 @@
 #include "code_player_system.h"
 #include "tile_utils.h"
 #include "paint.h"
+#include "cpu_turbo.h"
 
 // External function declarations
 extern void display_selective_level_code_fast(void) BANKED;
@@ -167,7 +168,9 @@ void validate_all_block_patterns(void) BANKED
 void reconstruct_tilemap_from_level_code(void) BANKED
 {
     // Use extension function to save bank space
+    cpu_turbo_begin();
     reconstruct_tilemap_from_level_code_ext();
+    cpu_turbo_end();
 }
 
 // Helper function to check if there's a platform in adjacent segment
@@ -1,6 +1,7 @@
 #pragma bank 253
 
 #include <gbdk/platform.h>
+#include <string.h>
 #include "code_platform_system.h"
 #include "code_level_core.h"
 #include "tile_utils.h"
@@ -25,9 +26,9 @@ void place_platform_run_ext(UBYTE start_x, UBYTE y, UBYTE length, UBYTE connecte
 
 // External declarations from main platform system
 extern UBYTE has_adjacent_platform(UBYTE block_index, BYTE direction) BANKED;
-extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED;
+extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) NONBANKED;
 extern void paint(UBYTE x, UBYTE y) BANKED;
-extern void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_type, UBYTE update_display) BANKED;
+extern void replace_meta_tile(UBYTE x, UBYTE y, UBYTE tile_type, UBYTE update_display) NONBANKED;
 extern void update_neighboring_block_codes(UBYTE block_index) BANKED;
 extern void update_single_block_code(UBYTE block_index) BANKED;
 extern void mark_display_position_for_update(UBYTE position) BANKED;
@@ -40,6 +41,7 @@ extern void rebuild_platform_row(UBYTE y) BANKED;
 void extract_platform_data_ext(void) BANKED;
 UBYTE extract_chunk_pattern_ext(UBYTE x, UBYTE y) BANKED;
 UBYTE match_platform_pattern_ext(UBYTE pattern) BANKED;
+void refresh_row_patterns_ext(UBYTE row_index) BANKED;
 UBYTE is_pattern_valid_for_position_ext(UBYTE pattern_id, UBYTE block_x) BANKED;
 UBYTE get_next_valid_pattern_ext(UBYTE current_pattern, UBYTE block_x) BANKED;
 UBYTE get_previous_valid_pattern_ext(UBYTE current_pattern, UBYTE block_x) BANKED;
@@ -54,58 +56,32 @@ UBYTE get_suppress_display_updates_ext(void) BANKED;
 // PLATFORM PATTERN DATA (MOVED FROM BANK 254)
 // ============================================================================
 
+// Tables are generated from tools/level_format/level_format.json (see level_format.h)
+
 // Simplified 5-bit patterns (bottom 5 bits from original patterns)
-const UBYTE PLATFORM_PATTERNS[] = {
-    0b00000, // UID 0: Empty
-    0b00001, // UID 1: Single platform at position 4
-    0b10000, // UID 2: Single platform at position 3
-    0b00011, // UID 3: Two platforms at positions 3-4
-    0b11000, // UID 4: Two platforms at positions 2-3
-    0b00110, // UID 5: Two platforms at positions 2-3
-    0b01100, // UID 6: Two platforms at positions 1-2
-    0b00111, // UID 7: Three platforms at positions 2-4
-    0b11100, // UID 8: Three platforms at positions 1-3
-    0b01101, // UID 9: Gapped platforms at positions 1-2,4
-    0b10110, // UID 10: Gapped platforms at positions 1,3-4
-    0b01110, // UID 11: Three platforms at positions 1-3
-    0b01111, // UID 12: Four platforms at positions 1-4
-    0b11110, // UID 13: Four platforms at positions 1-4
-    0b10001, // UID 14: Two isolated platforms at positions 0,4
-    0b10011, // UID 15: Three platforms at positions 0,3-4
-    0b11001, // UID 16: Three platforms at positions 0,2-3
-    0b10111, // UID 17: Four platforms at positions 0,2-4
-    0b11101, // UID 18: Four platforms at positions 0-2,4
-    0b11011, // UID 19: Four platforms at positions 0-1,3-4
-    0b11111  // UID 20: Full platform coverage
-};
+const UBYTE PLATFORM_PATTERNS[] = PLATFORM_PATTERNS_INIT;
+
+// Reverse lookup: 5-bit row mask -> pattern ID (PATTERN_NONE if no pattern matches)
+const UBYTE PATTERN_FROM_BITS[] = PATTERN_FROM_BITS_INIT;
 
 // Character mapping for pattern display (0-9, A-K for patterns 0-20)
-const UBYTE PATTERN_TILE_MAP[] = {
-    48, 49, 50, 51, 52, 53, 54, 55, 56, 57,    // 0-9
-    58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68 // A-K
-};
+const UBYTE PATTERN_TILE_MAP[] = PATTERN_TILE_MAP_INIT;
 
 // Extended character mapping for 0-34 range (supports column encoding)
-const UBYTE EXTENDED_PATTERN_TILE_MAP[] = {
-    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, // 0-9
-    58, 59, 60, 61, 62, 63, 64, 65, 66, 67, // A-J (10-19)
-    68, 69, 70, 71, 72, 73, 74, 75, 76, 77, // K-T (20-29)
-    78, 79, 80, 81, 82                      // U-Y (30-34)
-};
+const UBYTE EXTENDED_PATTERN_TILE_MAP[] = EXTENDED_PATTERN_TILE_MAP_INIT;
 
 // ============================================================================
 // PATTERN VALIDATION DATA (MOVED FROM BANK 254)
 // ============================================================================
 
-// Invalid patterns for first column (block_x = 0) - patterns that have platforms at leftmost position
-// These patterns have their leftmost bit (position 0) set: 2, 10, 14, 15, 17 (in hex: 2, A, E, F, H)
-const UBYTE INVALID_PATTERNS_FIRST_COLUMN[] = {2, 10, 14, 15, 17};
-#define INVALID_PATTERNS_FIRST_COLUMN_COUNT 5
+// Per-pattern PATTERN_NEEDS_LEFT/RIGHT flags (lone tile on a block edge)
+const UBYTE PATTERN_EDGE_FLAGS[] = PATTERN_EDGE_FLAGS_INIT;
+
+// Invalid patterns for first column (block_x = 0) - patterns with a lone platform at the leftmost position
+const UBYTE INVALID_PATTERNS_FIRST_COLUMN[] = INVALID_PATTERNS_FIRST_COLUMN_INIT;
 
-// Invalid patterns for last column (block_x = 3) - patterns that have platforms at rightmost position
-// These patterns have their rightmost bit (position 4) set: 1, 9, 14, 16, 18 (in hex: 1, 9, E, G, I)
-const UBYTE INVALID_PATTERNS_LAST_COLUMN[] = {1, 9, 14, 16, 18};
-#define INVALID_PATTERNS_LAST_COLUMN_COUNT 5
+// Invalid patterns for last column (block_x = SEGMENTS_PER_ROW - 1) - patterns with a lone platform at the rightmost position
+const UBYTE INVALID_PATTERNS_LAST_COLUMN[] = INVALID_PATTERNS_LAST_COLUMN_INIT;
 
 // ============================================================================
 // CORE PATTERN EXTRACTION AND MATCHING (MOVED FROM BANK 254)
@@ -126,7 +102,7 @@ UBYTE extract_chunk_pattern_ext(UBYTE x, UBYTE y) BANKED
 
         if (tile == PLATFORM_TILE_1 || tile == PLATFORM_TILE_2 || tile == PLATFORM_TILE_3)
         {
-            pattern |= (1 << (4 - i)); // Set bit for this position (bit 4 = position 0, bit 0 = position 4)
+            pattern |= (1 << (SEGMENT_WIDTH - 1 - i)); // Leftmost position in the high bit
         }
     }
 
@@ -135,81 +111,56 @@ UBYTE extract_chunk_pattern_ext(UBYTE x, UBYTE y) BANKED
 
 UBYTE match_platform_pattern_ext(UBYTE pattern) BANKED
 {
-    for (UBYTE i = 0; i < PLATFORM_PATTERN_COUNT; i++)
-    {
-        if (PLATFORM_PATTERNS[i] == pattern)
-        {
-            return i;
-        }
-    }
-    return 0; // Fallback to pattern 0
+    UBYTE pattern_id = PATTERN_FROM_BITS[pattern & PATTERN_BITS_MASK];
+    return (pattern_id == PATTERN_NONE) ? 0 : pattern_id; // Fallback to pattern 0
 }
 
 // ============================================================================
 // SURGICAL SUPPRESSION SYSTEM DATA (MOVED FROM BANK 254)
 // ============================================================================
 
-// Block-specific suppression flags (16 blocks = 16 bits in 2 bytes)
-UWORD suppressed_blocks = 0;
+// Block-specific suppression flags (one bit per block)
+UBYTE suppressed_blocks[BLOCK_MASK_BYTES];
 
 // Global flag to suppress all display updates during pattern application
 UBYTE suppress_display_updates = 0;
 
+// Re-extract the pattern of every unsuppressed block on a platform row.
+// Runs the whole row inside this bank so the painter pays one far call
+// instead of three per block
+void refresh_row_patterns_ext(UBYTE row_index) BANKED
+{
+    UBYTE zone_index = row_index * SEGMENTS_PER_ROW;
+    UBYTE segment_x = PLATFORM_X_MIN;
+    UBYTE segment_y = PLATFORM_Y_MIN + row_index * SEGMENT_HEIGHT;
+
+    for (UBYTE col = 0; col < SEGMENTS_PER_ROW; col++, zone_index++, segment_x += SEGMENT_WIDTH)
+    {
+        // Skip blocks whose pattern is being applied programmatically
+        if (BLOCK_MASK_TEST(suppressed_blocks, zone_index))
+            continue;
+
+        UBYTE pattern = extract_chunk_pattern_ext(segment_x, segment_y);
+        current_level_code.platform_patterns[zone_index] = match_platform_pattern_ext(pattern);
+    }
+}
+
 // ============================================================================
 // PATTERN VALIDATION FUNCTIONS (MOVED FROM BANK 254)
 // ============================================================================
 
-// Fast validation using direct array lookup (optimized for fixed system)
+// Fast validation using direct array lookup
+// Patterns with a lone platform on a block edge (1, 2, 9, 10, 14-18) need the
+// neighbouring block to connect to, so they are invalid in the outer columns
 UBYTE is_pattern_valid_for_position_ext(UBYTE pattern_id, UBYTE block_x) BANKED
 {
-    // Special handling for Pattern E/14 (platforms at both leftmost and rightmost positions)
-    if (pattern_id == 14) {
-        // Pattern E needs both left and right neighbors to work
-        // Only valid in the middle columns (block_x = 1 or 2)
-        return (block_x > 0 && block_x < (SEGMENTS_PER_ROW - 1)) ? 1 : 0;
-    }
-    
-    // Special handling for Pattern 1 (single platform at position 4)
-    if (pattern_id == 1) {
-        // Pattern 1 is only invalid in the last column (block_x=3) where it would spill over with no neighbor
-        if (block_x == 3) {
-            return 0;
-        }
-        // Valid everywhere else
-        return 1;
-    }
-
-    // Special handling for Pattern 2 (single platform at position 0)
-    if (pattern_id == 2) {
-        // Pattern 2 is only invalid in the first column (block_x=0) where it would spill over with no neighbor
-        if (block_x == 0) {
-            return 0;
-        }
-        // Valid everywhere else
-        return 1;
-    }
-    
-    // For the leftmost column (block_x=0), we restrict patterns with the leftmost bit set
-    // that aren't covered by the special cases above
-    if (block_x == 0) {
-        // Patterns with leftmost bit set: 10, 15, 17
-        // Convert pattern IDs to hex values: A=10, F=15, H=17
-        if (pattern_id == 10 || pattern_id == 15 || pattern_id == 17) {
-            return 0;
-        }
-    }
-    
-    // For the rightmost column (block_x=3), we restrict patterns with the rightmost bit set
-    // that aren't covered by the special cases above
-    if (block_x == 3) {
-        // Patterns with rightmost bit set: 9, 16, 18
-        // Convert pattern IDs to hex values: 9=9, G=16, I=18
-        if (pattern_id == 9 || pattern_id == 16 || pattern_id == 18) {
-            return 0;
-        }
-    }
-    
-    // All other patterns are valid in all positions
+    if (pattern_id >= PLATFORM_PATTERN_COUNT || block_x >= SEGMENTS_PER_ROW)
+        return 0;
+    UBYTE flags = PATTERN_EDGE_FLAGS[pattern_id];
+    if ((flags & PATTERN_NEEDS_LEFT) && block_x == 0)
+        return 0;
+    if ((flags & PATTERN_NEEDS_RIGHT) && block_x == (SEGMENTS_PER_ROW - 1))
+        return 0;
     return 1;
 }
 
@@ -267,7 +218,7 @@ void suppress_code_updates_for_block_ext(UBYTE block_index) BANKED
 {
     if (block_index < TOTAL_BLOCKS)
     {
-        suppressed_blocks |= (1 << block_index);
+        BLOCK_MASK_SET(suppressed_blocks, block_index);
     }
 }
 
@@ -276,7 +227,7 @@ void enable_code_updates_for_block_ext(UBYTE block_index) BANKED
 {
     if (block_index < TOTAL_BLOCKS)
     {
-        suppressed_blocks &= ~(1 << block_index);
+        BLOCK_MASK_CLEAR(suppressed_blocks, block_index);
     }
 }
 
@@ -285,13 +236,13 @@ UBYTE is_block_suppressed_ext(UBYTE block_index) BANKED
 {
     if (block_index >= TOTAL_BLOCKS)
         return 0;
-    return (suppressed_blocks & (1 << block_index)) != 0;
+    return BLOCK_MASK_TEST(suppressed_blocks, block_index) != 0;
 }
 
 // Clear all suppression flags
 void clear_all_suppression_ext(void) BANKED
 {
-    suppressed_blocks = 0;
+    memset(suppressed_blocks, 0, sizeof(suppressed_blocks));
     suppress_display_updates = 0;
 }
 
@@ -312,14 +263,13 @@ UBYTE get_suppress_display_updates_ext(void) BANKED
 
 void extract_platform_data_ext(void) BANKED
 {
-    for (UBYTE block_y = 0; block_y < 4; block_y++)
+    UBYTE block_index = 0;
+    UBYTE segment_y = PLATFORM_Y_MIN;
+    for (UBYTE block_y = 0; block_y < SEGMENT_ROWS; block_y++, segment_y += SEGMENT_HEIGHT)
     {
-        for (UBYTE block_x = 0; block_x < 4; block_x++)
+        UBYTE segment_x = PLATFORM_X_MIN;
+        for (UBYTE block_x = 0; block_x < SEGMENTS_PER_ROW; block_x++, block_index++, segment_x += SEGMENT_WIDTH)
         {
-            UBYTE block_index = block_y * 4 + block_x;
-            UBYTE segment_x = 2 + block_x * SEGMENT_WIDTH;
-            UBYTE segment_y = PLATFORM_Y_MIN + block_y * SEGMENT_HEIGHT;
-
             UBYTE pattern = extract_chunk_pattern_ext(segment_x, segment_y);
             UBYTE pattern_id = match_platform_pattern_ext(pattern);
 
@@ -335,13 +285,13 @@ void extract_platform_data_ext(void) BANKED
 // LEVEL CODE INTEGRATION FUNCTIONS (BANK 253)
 // ============================================================================
 
-// Convert character index (0-15) to block position for pattern validation
+// Convert character index (0 to TOTAL_BLOCKS - 1) to block position for pattern validation
 UBYTE get_block_x_from_char_index(UBYTE char_index) BANKED
 {
     if (char_index >= TOTAL_BLOCKS)
         return 255; // Invalid
 
-    return char_index % SEGMENTS_PER_ROW; // Returns 0-3 for columns
+    return char_index % SEGMENTS_PER_ROW; // Block column
 }
 
 // Get next valid pattern for level code editing (character-index based)
@@ -364,7 +314,7 @@ UBYTE get_previous_valid_pattern_for_char(UBYTE char_index, UBYTE current_patter
     return get_previous_valid_pattern_ext(current_pattern, block_x);
 }
 
-// Check if pattern is valid for a specific character index (0-15)
+// Check if pattern is valid for a specific character index (0 to TOTAL_BLOCKS - 1)
 UBYTE is_pattern_valid_for_char_index(UBYTE char_index, UBYTE pattern_id) BANKED
 {
     if (char_index >= TOTAL_BLOCKS)
@@ -428,34 +378,25 @@ void apply_valid_pattern_to_block_ext(UBYTE block_index, UBYTE pattern_id) BANKE
     UBYTE right_neighbor_index = 0;
     UBYTE right_neighbor_pattern = 0;
 
-    // Check for patterns with rightmost platform (position 4) - Patterns 1, 9, 14, 16, 18
+    // Check for patterns with a lone rightmost platform - Patterns 1, 9, 14, 16, 18
     // These patterns need to connect to the right neighbor's leftmost position
-    if ((pattern_id == 1 || pattern_id == 9 || pattern_id == 14 || pattern_id == 16 || 
-         pattern_id == 18) && block_x < (SEGMENTS_PER_ROW - 1)) 
+    if ((PATTERN_EDGE_FLAGS[pattern_id] & PATTERN_NEEDS_RIGHT) && block_x < (SEGMENTS_PER_ROW - 1))
     {
         right_neighbor_index = block_index + 1;
         UBYTE current_neighbor_pattern = current_level_code.platform_patterns[right_neighbor_index];
         
         // We need to set leftmost bit in right neighbor's pattern
         UBYTE neighbor_bits = PLATFORM_PATTERNS[current_neighbor_pattern];
-        neighbor_bits |= 0b10000; // Set leftmost bit
+        neighbor_bits |= (1 << (SEGMENT_WIDTH - 1)); // Set leftmost bit
         
         // Find matching pattern for modified bits
-        for (UBYTE i = 0; i < PLATFORM_PATTERN_COUNT; i++) 
-        {
-            if (PLATFORM_PATTERNS[i] == neighbor_bits) 
-            {
-                right_neighbor_pattern = i;
-                need_to_update_right = 1;
-                break;
-            }
-        }
+        right_neighbor_pattern = PATTERN_FROM_BITS[neighbor_bits];
+        need_to_update_right = (right_neighbor_pattern != PATTERN_NONE);
     }
     
-    // Check for patterns with leftmost platform (position 0) - Patterns 2, 10, 14, 15, 17
+    // Check for patterns with a lone leftmost platform - Patterns 2, 10, 14, 15, 17
     // These patterns need to connect to the left neighbor's rightmost position
-    if ((pattern_id == 2 || pattern_id == 10 || pattern_id == 14 || pattern_id == 15 || 
-         pattern_id == 17) && block_x > 0) 
+    if ((PATTERN_EDGE_FLAGS[pattern_id] & PATTERN_NEEDS_LEFT) && block_x > 0)
     {
         left_neighbor_index = block_index - 1;
         UBYTE current_neighbor_pattern = current_level_code.platform_patterns[left_neighbor_index];
@@ -465,15 +406,8 @@ void apply_valid_pattern_to_block_ext(UBYTE block_index, UBYTE pattern_id) BANKE
         neighbor_bits |= 0b00001; // Set rightmost bit
         
         // Find matching pattern for modified bits
-        for (UBYTE i = 0; i < PLATFORM_PATTERN_COUNT; i++) 
-        {
-            if (PLATFORM_PATTERNS[i] == neighbor_bits) 
-            {
-                left_neighbor_pattern = i;
-                need_to_update_left = 1;
-                break;
-            }
-        }
+        left_neighbor_pattern = PATTERN_FROM_BITS[neighbor_bits];
+        need_to_update_left = (left_neighbor_pattern != PATTERN_NONE);
     }
 
     // Set the intended pattern in level code FIRST (so display shows correct pattern immediately)
@@ -586,7 +520,7 @@ void apply_pattern_to_tilemap_ext(UBYTE block_index, UBYTE pattern_id) BANKED
     // Calculate block position in tilemap
     UBYTE block_x = block_index % SEGMENTS_PER_ROW;
     UBYTE block_y = block_index / SEGMENTS_PER_ROW;
-    UBYTE segment_x = 2 + block_x * SEGMENT_WIDTH;
+    UBYTE segment_x = PLATFORM_X_MIN + block_x * SEGMENT_WIDTH;
     UBYTE segment_y = PLATFORM_Y_MIN + block_y * SEGMENT_HEIGHT;
 
     // Get the pattern data
@@ -631,7 +565,7 @@ void apply_pattern_with_brush_logic_ext(UBYTE block_index, UBYTE pattern_id) BAN
     // Calculate block position in tilemap
     UBYTE block_x = block_index % SEGMENTS_PER_ROW;
     UBYTE block_y = block_index / SEGMENTS_PER_ROW;
-    UBYTE segment_x = 2 + block_x * SEGMENT_WIDTH;
+    UBYTE segment_x = PLATFORM_X_MIN + block_x * SEGMENT_WIDTH;
     UBYTE segment_y = PLATFORM_Y_MIN + block_y * SEGMENT_HEIGHT;
 
     // Get the pattern data
@@ -660,7 +594,7 @@ void apply_pattern_with_brush_logic_ext(UBYTE block_index, UBYTE pattern_id) BAN
     // Place platforms using direct tile replacement (paint system approach)
     for (UBYTE i = 0; i < SEGMENT_WIDTH; i++)
     {
-        if (pattern & (1 << (4 - i))) // Check if this position should have a platform
+        if (pattern & (1 << (SEGMENT_WIDTH - 1 - i))) // Check if this position should have a platform
         {
             UBYTE tile_x = segment_x + i;
 
@@ -676,8 +610,7 @@ void apply_pattern_with_brush_logic_ext(UBYTE block_index, UBYTE pattern_id) BAN
     // Special case handling for cross-block platforms
     // Check for rightmost platform (position 4) that needs to connect to right neighbor
     // Patterns with rightmost bit: 1, 9, 14, 16, 18
-    if ((pattern_id == 1 || pattern_id == 9 || pattern_id == 14 || pattern_id == 16 || 
-         pattern_id == 18) && block_x < (SEGMENTS_PER_ROW - 1)) 
+    if ((PATTERN_EDGE_FLAGS[pattern_id] & PATTERN_NEEDS_RIGHT) && block_x < (SEGMENTS_PER_ROW - 1))
     {
         // Make sure next block has a platform at position 0
         UBYTE next_block_x = segment_x + SEGMENT_WIDTH;
@@ -694,8 +627,7 @@ void apply_pattern_with_brush_logic_ext(UBYTE block_index, UBYTE pattern_id) BAN
     
     // Check for leftmost platform (position 0) that needs to connect to left neighbor
     // Patterns with leftmost bit: 2, 10, 14, 15, 17
-    if ((pattern_id == 2 || pattern_id == 10 || pattern_id == 14 || pattern_id == 15 || 
-         pattern_id == 17) && block_x > 0) 
+    if ((PATTERN_EDGE_FLAGS[pattern_id] & PATTERN_NEEDS_LEFT) && block_x > 0)
     {
         // Make sure previous block has a platform at position 4
         UBYTE prev_block_x = segment_x - 1;
@@ -749,7 +681,7 @@ void update_all_affected_block_codes_ext(UBYTE block_index) BANKED
     }
 
     // Below neighbor
-    if (current_row < 3) // 4 total rows (0-3)
+    if (current_row < (SEGMENT_ROWS - 1))
     {
         UBYTE below_neighbor = block_index + SEGMENTS_PER_ROW;
         update_single_block_code(below_neighbor);
@@ -783,7 +715,7 @@ void validate_final_pattern_match_ext(UBYTE block_index, UBYTE intended_pattern_
     // Extract the actual pattern from the tilemap
     UBYTE block_x = block_index % SEGMENTS_PER_ROW;
     UBYTE block_y = block_index / SEGMENTS_PER_ROW;
-    UBYTE segment_x = 2 + block_x * SEGMENT_WIDTH;
+    UBYTE segment_x = PLATFORM_X_MIN + block_x * SEGMENT_WIDTH;
     UBYTE segment_y = PLATFORM_Y_MIN + block_y * SEGMENT_HEIGHT;
 
     UBYTE actual_pattern = extract_chunk_pattern_ext(segment_x, segment_y);
@@ -815,7 +747,7 @@ void apply_row_platforms_ext(UBYTE base_x, UBYTE y, UBYTE row_pattern, UBYTE has
     UBYTE start_pos = 255;
     for (UBYTE i = 0; i < SEGMENT_WIDTH; i++)
     {
-        UBYTE has_platform = (row_pattern & (1 << (4 - i))) != 0;
+        UBYTE has_platform = (row_pattern & (1 << (SEGMENT_WIDTH - 1 - i))) != 0;
 
         if (has_platform && start_pos == 255)
         {
@@ -19,8 +19,8 @@ extern const UBYTE PLATFORM_PATTERNS[];
 extern UBYTE paint_player_id;
 
 // Valid player position tracking - paint-system tied approach
-UBYTE column_has_platform[20];  // 1 if column has at least one platform, 0 if not
-UBYTE valid_player_columns[20]; // Cached list of valid columns for cycling
+UBYTE column_has_platform[PLATFORM_COLUMNS];  // 1 if column has at least one platform, 0 if not
+UBYTE valid_player_columns[PLATFORM_COLUMNS]; // Cached list of valid columns for cycling
 UBYTE valid_player_count = 0;
 
 // ============================================================================
@@ -29,14 +29,14 @@ UBYTE valid_player_count = 0;
 
 void extract_player_data(void) BANKED
 {
-    for (UBYTE col = 2; col < 22; col++)
+    for (UBYTE col = PLATFORM_X_MIN; col <= PLATFORM_X_MAX; col++)
     {
-        UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(col, 11)];
+        UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(col, PLAYER_ROW)];
         UBYTE tile_type = get_tile_type(tile);
 
         if (tile_type == BRUSH_TILE_PLAYER)
         {
-            current_level_code.player_column = col - 2; // 0-based column
+            current_level_code.player_column = col - PLATFORM_X_MIN; // 0-based column
             return;
         }
     }
@@ -51,7 +51,7 @@ void extract_player_data(void) BANKED
 void init_column_platform_tracking(void) BANKED
 {
     // Clear all tracking arrays
-    for (UBYTE col = 0; col < 20; col++)
+    for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++)
     {
         column_has_platform[col] = 0;
     }
@@ -65,26 +65,23 @@ void init_column_platform_tracking(void) BANKED
 void refresh_column_platform_tracking(void) BANKED
 {
     // Clear existing tracking
-    for (UBYTE col = 0; col < 20; col++)
+    for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++)
     {
         column_has_platform[col] = 0;
     }
 
-    // Scan ALL rows and columns (2-21 in tilemap, 0-19 in level code) for ANY platform tiles
-    for (UBYTE row = 0; row < 24; row++) // Check all possible rows
+    // Scan the platform rows of every level column for ANY platform tiles
+    for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
     {
-        for (UBYTE col = 2; col < 22; col++)
+        UBYTE y = PLATFORM_ROW_Y(row);
+        for (UBYTE level_col = 0; level_col < PLATFORM_COLUMNS; level_col++)
         {
-            UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(col, row)];
+            UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(PLATFORM_X_MIN + level_col, y)];
             UBYTE tile_type = get_tile_type(tile);
 
             if (tile_type == BRUSH_TILE_PLATFORM)
             {
-                UBYTE level_col = col - 2; // Convert to 0-19 range
-                if (level_col < 20)
-                {
-                    column_has_platform[level_col] = 1; // Mark this column as having a platform
-                }
+                column_has_platform[level_col] = 1; // Mark this column as having a platform
             }
         }
     }
@@ -98,7 +95,7 @@ void rebuild_valid_player_list(void) BANKED
 {
     valid_player_count = 0;
 
-    for (UBYTE col = 0; col < 20; col++)
+    for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++)
     {
         if (column_has_platform[col])
         {
@@ -121,9 +118,9 @@ void update_column_platform_painted(UBYTE tilemap_col, UBYTE tilemap_row) BANKED
 {
     (void)tilemap_row; // Suppress unused parameter warning
 
-    // Convert to level column (0-19 range)
-    UBYTE level_col = tilemap_col - 2;
-    if (level_col < 20)
+    // Convert to level column (0 to PLATFORM_COLUMNS - 1)
+    UBYTE level_col = tilemap_col - PLATFORM_X_MIN;
+    if (level_col < PLATFORM_COLUMNS)
     {
         // Simply mark this column as having a platform (regardless of row)
         if (!column_has_platform[level_col])
@@ -139,15 +136,15 @@ void update_column_platform_deleted(UBYTE tilemap_col, UBYTE tilemap_row) BANKED
 {
     (void)tilemap_row; // Suppress unused parameter warning
 
-    // Convert to level column (0-19 range)
-    UBYTE level_col = tilemap_col - 2;
-    if (level_col < 20)
+    // Convert to level column (0 to PLATFORM_COLUMNS - 1)
+    UBYTE level_col = tilemap_col - PLATFORM_X_MIN;
+    if (level_col < PLATFORM_COLUMNS)
     {
-        // Check if this column still has ANY platforms after deletion (scan all rows)
+        // Check if this column still has ANY platforms after deletion (platform rows only)
         UBYTE still_has_platform = 0;
-        for (UBYTE row = 0; row < 24; row++) // Check all possible rows
+        for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
         {
-            UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(tilemap_col, row)];
+            UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(tilemap_col, PLATFORM_ROW_Y(row))];
             UBYTE tile_type = get_tile_type(tile);
             if (tile_type == BRUSH_TILE_PLATFORM)
             {
@@ -256,8 +253,8 @@ void position_player_at_valid_location(void) BANKED
 void update_exit_position_after_platform_change(void) BANKED
 {
     // Get current player position in tile coordinates
-    UBYTE player_x = current_level_code.player_column + 2; // Convert to tile coordinates
-    UBYTE player_y = 11;                                   // Player is always on row 11
+    UBYTE player_x = current_level_code.player_column + PLATFORM_X_MIN; // Convert to tile coordinates
+    UBYTE player_y = PLAYER_ROW;                                        // Player is always on PLAYER_ROW
 
     // Check if player is still in a valid position after platform changes
     if (!is_valid_player_position(current_level_code.player_column))
@@ -266,7 +263,7 @@ void update_exit_position_after_platform_change(void) BANKED
         if (valid_player_count > 0)
         {
             current_level_code.player_column = valid_player_columns[0];
-            player_x = current_level_code.player_column + 2;
+            player_x = current_level_code.player_column + PLATFORM_X_MIN;
 
             // Update the player's visual position on the tilemap
             clear_existing_player_on_row_11();
@@ -274,7 +271,7 @@ void update_exit_position_after_platform_change(void) BANKED
             move_player_actor_to_tile(paint_player_id, player_x, player_y);
 
             // Mark player position for display update
-            mark_display_position_for_update(16);
+            mark_display_position_for_update(LEVEL_CODE_PLAYER_INDEX);
         }
     }
 
@@ -323,7 +320,7 @@ void test_valid_player_positions(void) BANKED
 void handle_player_position_edit(UBYTE new_value) BANKED
 {
     // Update player position when level code changes
-    if (new_value < 20) // Valid column range 0-19
+    if (new_value < PLATFORM_COLUMNS) // Valid column range
     {
         // Check if the new position is valid (has a platform)
         if (is_valid_player_position(new_value))
@@ -332,20 +329,20 @@ void handle_player_position_edit(UBYTE new_value) BANKED
 
             // Update the tilemap to reflect the new player position
             // Clear old player position
-            for (UBYTE col = 2; col < 22; col++)
+            for (UBYTE col = PLATFORM_X_MIN; col <= PLATFORM_X_MAX; col++)
             {
-                UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(col, 11)];
+                UBYTE tile = sram_map_data[METATILE_MAP_OFFSET(col, PLAYER_ROW)];
                 UBYTE tile_type = get_tile_type(tile);
                 if (tile_type == BRUSH_TILE_PLAYER)
                 {
-                    replace_meta_tile(col, 11, 0, 1); // Clear old position
+                    replace_meta_tile(col, PLAYER_ROW, 0, 1); // Clear old position
                 }
             }
 
             // Set new player position
-            UBYTE new_col = 2 + new_value; // Convert to tilemap coordinate
+            UBYTE new_col = PLATFORM_X_MIN + new_value; // Convert to tilemap coordinate
             // Use appropriate player tile - assuming there's a player tile constant
-            replace_meta_tile(new_col, 11, 1, 1); // Place player at new position
+            replace_meta_tile(new_col, PLAYER_ROW, 1, 1); // Place player at new position
         }
         // If new position is not valid, don't change the player position
     }
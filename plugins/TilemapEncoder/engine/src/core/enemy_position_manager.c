@@ -9,18 +9,24 @@
 // ============================================================================
 
 // Pre-calculated valid enemy positions based on platform layout
-UBYTE valid_enemy_positions[4][20]; // [row][column] - 1 if valid, 0 if not
-UBYTE valid_enemy_positions_count;
+UBYTE valid_enemy_positions[SEGMENT_ROWS][PLATFORM_COLUMNS]; // [row][column] - 1 if valid, 0 if not
+UWORD valid_enemy_positions_count;
+
+// Valid positions per row, so a platform edit only rescans the row above it
+static UBYTE valid_enemy_row_counts[SEGMENT_ROWS];
+
+// Set while the code editor fallback (every position valid) is in use
+static UBYTE valid_enemy_positions_fallback;
 
 // Platform positions cache - updated when platforms change
-UBYTE platform_positions[4][20]; // [platform_row][column] - 1 if platform exists
+UBYTE platform_positions[SEGMENT_ROWS][PLATFORM_COLUMNS]; // [platform_row][column] - 1 if platform exists
 
-// Enemy position row mapping
-const UBYTE ENEMY_ROWS[4] = {12, 14, 16, 18};
-const UBYTE PLATFORM_ROWS[4] = {13, 15, 17, 19};
+// Enemy position row mapping (generated from the level format spec)
+const UBYTE ENEMY_ROWS[SEGMENT_ROWS] = ENEMY_ROWS_INIT;
+const UBYTE PLATFORM_ROWS[SEGMENT_ROWS] = PLATFORM_ROWS_INIT;
 
 // External function declarations
-extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED;
+extern UBYTE get_current_tile_type(UBYTE x, UBYTE y) NONBANKED;
 extern UBYTE is_valid_platform_row(UBYTE y) BANKED;
 extern void clear_enemy_actor(UBYTE enemy_index) BANKED;
 
@@ -28,39 +34,31 @@ extern void clear_enemy_actor(UBYTE enemy_index) BANKED;
 // PLATFORM TRACKING SYSTEM
 // ============================================================================
 
-// Update platform positions cache when platforms change
-void update_platform_positions(void) BANKED
+// Rescan the platform cache of a single platform row
+void update_platform_positions_row(UBYTE row) BANKED
 {
-    // Clear platform cache
-    for (UBYTE row = 0; row < 4; row++)
+    UBYTE platform_y = PLATFORM_ROWS[row];
+    UBYTE *cache = platform_positions[row];
+    UBYTE x = PLATFORM_X_MIN;
+    for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++, x++)
     {
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            platform_positions[row][col] = 0;
-        }
+        cache[col] = (get_current_tile_type(x, platform_y) == BRUSH_TILE_PLATFORM);
     }
+}
 
-    // Scan for existing platforms
-    for (UBYTE row = 0; row < 4; row++)
+// Update platform positions cache when platforms change
+void update_platform_positions(void) BANKED
+{
+    for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
     {
-        UBYTE platform_y = PLATFORM_ROWS[row];
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            UBYTE x = PLATFORM_X_MIN + col;
-            UBYTE tile_type = get_current_tile_type(x, platform_y);
-            
-            if (tile_type == BRUSH_TILE_PLATFORM)
-            {
-                platform_positions[row][col] = 1;
-            }
-        }
+        update_platform_positions_row(row);
     }
 }
 
 // Check if there's a platform directly below an enemy position
 UBYTE has_platform_below_cached(UBYTE enemy_row, UBYTE col) BANKED
 {
-    if (enemy_row >= 4 || col >= 20)
+    if (enemy_row >= SEGMENT_ROWS || col >= PLATFORM_COLUMNS)
         return 0;
     
     return platform_positions[enemy_row][col];
@@ -78,20 +76,11 @@ UBYTE is_valid_enemy_position_unified(UBYTE x, UBYTE y) BANKED
         return 0;
     
     UBYTE col = x - PLATFORM_X_MIN;
-    UBYTE enemy_row = 255;
     
     // Find which enemy row this corresponds to
-    for (UBYTE i = 0; i < 4; i++)
-    {
-        if (y == ENEMY_ROWS[i])
-        {
-            enemy_row = i;
-            break;
-        }
-    }
-    
-    if (enemy_row == 255)
+    if (!IS_ENEMY_ROW(y))
         return 0; // Not a valid enemy row
+    UBYTE enemy_row = SEGMENT_ROW_OF(y);
     
     // Must have platform directly below
     if (!has_platform_below_cached(enemy_row, col))
@@ -221,44 +210,44 @@ UBYTE is_valid_enemy_position_for_enemy(UBYTE x, UBYTE y, UBYTE enemy_index) BAN
 // VALID POSITIONS SYSTEM
 // ============================================================================
 
+// Recalculate the valid positions of one enemy row from the platform cache
+static void scan_valid_enemy_row(UBYTE row)
+{
+    UBYTE y = ENEMY_ROWS[row];
+    UBYTE *valid = valid_enemy_positions[row];
+    UBYTE count = 0;
+    UBYTE x = PLATFORM_X_MIN;
+    for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++, x++)
+    {
+        valid[col] = is_valid_enemy_position_unified(x, y);
+        count += valid[col];
+    }
+    valid_enemy_positions_count += count - valid_enemy_row_counts[row];
+    valid_enemy_row_counts[row] = count;
+}
+
 // Update the valid enemy positions matrix
 void update_valid_enemy_positions_unified(void) BANKED
 {
     // First update platform positions
     update_platform_positions();
     
-    // Clear valid positions
-    valid_enemy_positions_count = 0;
-    for (UBYTE row = 0; row < 4; row++)
-    {
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            valid_enemy_positions[row][col] = 0;
-        }
-    }
-    
     // Calculate valid positions
-    for (UBYTE row = 0; row < 4; row++)
+    valid_enemy_positions_count = 0;
+    for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
     {
-        UBYTE y = ENEMY_ROWS[row];
-        for (UBYTE col = 0; col < 20; col++)
-        {
-            UBYTE x = PLATFORM_X_MIN + col;
-            
-            if (is_valid_enemy_position_unified(x, y))
-            {
-                valid_enemy_positions[row][col] = 1;
-                valid_enemy_positions_count++;
-            }
-        }
+        valid_enemy_row_counts[row] = 0;
+        scan_valid_enemy_row(row);
     }
+    valid_enemy_positions_fallback = FALSE;
     
     // Fallback: If no valid positions found, allow basic positioning for code editor
     if (valid_enemy_positions_count == 0)
     {
-        for (UBYTE row = 0; row < 4; row++)
+        valid_enemy_positions_fallback = TRUE;
+        for (UBYTE row = 0; row < SEGMENT_ROWS; row++)
         {
-            for (UBYTE col = 0; col < 20; col++)
+            for (UBYTE col = 0; col < PLATFORM_COLUMNS; col++)
             {
                 UBYTE x = PLATFORM_X_MIN + col;
                 UBYTE y = ENEMY_ROWS[row];
@@ -273,16 +262,38 @@ void update_valid_enemy_positions_unified(void) BANKED
     }
 }
 
+// Update the valid positions of the enemy row above one platform row.
+// Platforms only support the row directly above them, so an edit costs
+// one row of the level rather than the whole matrix
+void update_valid_enemy_positions_row(UBYTE row) BANKED
+{
+    if (row >= SEGMENT_ROWS)
+        return;
+
+    // Leaving (or entering) the code editor fallback changes every row
+    if (valid_enemy_positions_fallback)
+    {
+        update_valid_enemy_positions_unified();
+        return;
+    }
+
+    update_platform_positions_row(row);
+    scan_valid_enemy_row(row);
+
+    if (valid_enemy_positions_count == 0)
+        update_valid_enemy_positions_unified();
+}
+
 // Get the next valid enemy position for cycling in level code editor
 UBYTE get_next_valid_enemy_position(UBYTE current_row, UBYTE current_col, UBYTE *next_row, UBYTE *next_col) BANKED
 {
     // Start searching from the position after current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (current_row + row_offset) % 4;
+        UBYTE row = (current_row + row_offset) % SEGMENT_ROWS;
         UBYTE start_col = (row_offset == 0) ? current_col + 1 : 0;
         
-        for (UBYTE col = start_col; col < 20; col++)
+        for (UBYTE col = start_col; col < PLATFORM_COLUMNS; col++)
         {
             if (valid_enemy_positions[row][col])
             {
@@ -307,10 +318,10 @@ UBYTE get_next_valid_enemy_position(UBYTE current_row, UBYTE current_col, UBYTE
 UBYTE get_prev_valid_enemy_position(UBYTE current_row, UBYTE current_col, UBYTE *prev_row, UBYTE *prev_col) BANKED
 {
     // Start searching backward from the position before current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (4 + current_row - row_offset) % 4;
-        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : 19;
+        UBYTE row = (SEGMENT_ROWS + current_row - row_offset) % SEGMENT_ROWS;
+        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : (PLATFORM_COLUMNS - 1);
         
         for (BYTE col = end_col; col >= 0; col--)
         {
@@ -337,12 +348,12 @@ UBYTE get_prev_valid_enemy_position(UBYTE current_row, UBYTE current_col, UBYTE
 UBYTE get_next_valid_enemy_position_for_enemy(UBYTE current_row, UBYTE current_col, UBYTE enemy_index, UBYTE *next_row, UBYTE *next_col) BANKED
 {
     // Start searching from the position after current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (current_row + row_offset) % 4;
+        UBYTE row = (current_row + row_offset) % SEGMENT_ROWS;
         UBYTE start_col = (row_offset == 0) ? current_col + 1 : 0;
         
-        for (UBYTE col = start_col; col < 20; col++)
+        for (UBYTE col = start_col; col < PLATFORM_COLUMNS; col++)
         {
             if (valid_enemy_positions[row][col])
             {
@@ -367,10 +378,10 @@ UBYTE get_next_valid_enemy_position_for_enemy(UBYTE current_row, UBYTE current_c
 UBYTE get_prev_valid_enemy_position_for_enemy(UBYTE current_row, UBYTE current_col, UBYTE enemy_index, UBYTE *prev_row, UBYTE *prev_col) BANKED
 {
     // Start searching backward from the position before current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (4 + current_row - row_offset) % 4;
-        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : 19;
+        UBYTE row = (SEGMENT_ROWS + current_row - row_offset) % SEGMENT_ROWS;
+        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : (PLATFORM_COLUMNS - 1);
         
         for (BYTE col = end_col; col >= 0; col--)
         {
@@ -397,12 +408,12 @@ UBYTE get_prev_valid_enemy_position_for_enemy(UBYTE current_row, UBYTE current_c
 UBYTE get_next_valid_enemy_position_for_specific_enemy(UBYTE current_row, UBYTE current_col, UBYTE enemy_index, UBYTE *next_row, UBYTE *next_col) BANKED
 {
     // Start searching from the position after current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (current_row + row_offset) % 4;
+        UBYTE row = (current_row + row_offset) % SEGMENT_ROWS;
         UBYTE start_col = (row_offset == 0) ? current_col + 1 : 0;
         
-        for (UBYTE col = start_col; col < 20; col++)
+        for (UBYTE col = start_col; col < PLATFORM_COLUMNS; col++)
         {
             if (valid_enemy_positions[row][col])
             {
@@ -427,10 +438,10 @@ UBYTE get_next_valid_enemy_position_for_specific_enemy(UBYTE current_row, UBYTE
 UBYTE get_prev_valid_enemy_position_for_specific_enemy(UBYTE current_row, UBYTE current_col, UBYTE enemy_index, UBYTE *prev_row, UBYTE *prev_col) BANKED
 {
     // Start searching backward from the position before current
-    for (UBYTE row_offset = 0; row_offset < 4; row_offset++)
+    for (UBYTE row_offset = 0; row_offset < SEGMENT_ROWS; row_offset++)
     {
-        UBYTE row = (4 + current_row - row_offset) % 4;
-        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : 19;
+        UBYTE row = (SEGMENT_ROWS + current_row - row_offset) % SEGMENT_ROWS;
+        BYTE end_col = (row_offset == 0) ? ((BYTE)current_col - 1) : (PLATFORM_COLUMNS - 1);
         
         for (BYTE col = end_col; col >= 0; col--)
         {
@@ -461,23 +472,14 @@ UBYTE get_prev_valid_enemy_position_for_specific_enemy(UBYTE current_row, UBYTE
 void tilemap_to_indices(UBYTE x, UBYTE y, UBYTE *row, UBYTE *col) BANKED
 {
     *col = x - PLATFORM_X_MIN;
-    *row = 255;
-    
-    for (UBYTE i = 0; i < 4; i++)
-    {
-        if (y == ENEMY_ROWS[i])
-        {
-            *row = i;
-            break;
-        }
-    }
+    *row = IS_ENEMY_ROW(y) ? SEGMENT_ROW_OF(y) : 255;
 }
 
 // Convert array indices to tilemap coordinates
 void indices_to_tilemap(UBYTE row, UBYTE col, UBYTE *x, UBYTE *y) BANKED
 {
     *x = PLATFORM_X_MIN + col;
-    *y = (row < 4) ? ENEMY_ROWS[row] : 12;
+    *y = (row < SEGMENT_ROWS) ? ENEMY_ROWS[row] : PLATFORM_Y_MIN;
 }
 
 // Convert row/col to POS41 value for level code
@@ -486,11 +488,11 @@ UBYTE indices_to_pos41(UBYTE row, UBYTE col, UBYTE odd_bit) BANKED
     // Suppress unused parameter warning
     (void)odd_bit;
     
-    if (row >= 4 || col >= 20)
+    if (row >= SEGMENT_ROWS || col >= PLATFORM_COLUMNS)
         return 0; // Invalid
     
     UBYTE anchor = col / 2;
-    return 1 + row * 10 + anchor;
+    return 1 + row * ENEMY_ANCHORS_PER_ROW + anchor;
 }
 
 // Convert POS41 value to row/col
@@ -503,9 +505,9 @@ void pos41_to_indices(UBYTE pos_value, UBYTE odd_bit, UBYTE *row, UBYTE *col) BA
         return;
     }
     
-    UBYTE v = pos_value - 1; // 0-39
-    *row = v / 10;           // 0-3
-    UBYTE anchor = v % 10;   // 0-9
+    UBYTE v = pos_value - 1;               // 0 to ENEMY_POS_MAX - 1
+    *row = v / ENEMY_ANCHORS_PER_ROW;       // Segment row
+    UBYTE anchor = v % ENEMY_ANCHORS_PER_ROW;
     *col = anchor * 2 + odd_bit;
 }
 
@@ -516,20 +518,22 @@ void pos41_to_indices(UBYTE pos_value, UBYTE odd_bit, UBYTE *row, UBYTE *col) BA
 // Called when a platform is added or removed
 void on_platform_changed(UBYTE x, UBYTE y) BANKED
 {
-    // Suppress unused parameter warning - x coordinate not needed for full recalculation
+    // Suppress unused parameter warning - the whole row is rescanned
     (void)x;
     
     // Only update if this affects enemy positioning
-    if (y == 13 || y == 15 || y == 17 || y == 19)
+    if (IS_PLATFORM_ROW(y))
     {
+        UBYTE row = SEGMENT_ROW_OF(y);
+
         // Update platform positions cache first
-        update_platform_positions();
+        update_platform_positions_row(row);
         
         // Clear any enemies that no longer have platforms
         clear_enemies_without_platforms();
         
         // Update valid enemy positions
-        update_valid_enemy_positions_unified();
+        update_valid_enemy_positions_row(row);
     }
 }
 
@@ -581,17 +585,7 @@ UBYTE is_valid_enemy_position_for_code(UBYTE x, UBYTE y) BANKED
         return 0;
     
     // Check if it's a valid enemy row
-    UBYTE is_enemy_row = 0;
-    for (UBYTE i = 0; i < 4; i++)
-    {
-        if (y == ENEMY_ROWS[i])
-        {
-            is_enemy_row = 1;
-            break;
-        }
-    }
-    
-    if (!is_enemy_row)
+    if (!IS_ENEMY_ROW(y))
         return 0;
     
     // For code-based placement, we allow placement even without platforms
@@ -627,7 +621,7 @@ UBYTE is_valid_offset_mask(UBYTE mask_value) BANKED
         UBYTE new_col = anchor * 2 + new_odd_bit;
         
         // Check bounds
-        if (new_col >= 20)
+        if (new_col >= PLATFORM_COLUMNS)
             return 0; // Would place enemy out of bounds
         
         // Calculate the tilemap position
@@ -27,14 +27,14 @@ void test_enemy_position_validation(void) BANKED
     
     // Test basic validation logic
     UBYTE test_x = 5;  // Column 3 in level code (5 - 2 = 3)
-    UBYTE test_y = 12; // Enemy row 0
+    UBYTE test_y = ENEMY_ROWS[0]; // Enemy row 0
     
     // This should pass basic checks (position, row validation)
     // Platform check would depend on actual platform data
     UBYTE is_valid = is_valid_enemy_position_unified(test_x, test_y);
     
     // Test 2: Invalid position - wrong row
-    UBYTE invalid_y = 11; // Not an enemy row
+    UBYTE invalid_y = PLAYER_ROW; // Not an enemy row
     UBYTE is_invalid = is_valid_enemy_position_unified(test_x, invalid_y);
     
     // Test 3: Position conversion utilities
@@ -0,0 +1,47 @@
+const id = "EVENT_LOAD_LEVEL_CODE_EXT";
+const groups = ["EVENT_GROUP_MISC"];
+const name = "Load Variable-Length Level Code";
+
+const fields = [
+  {
+    key: "variable",
+    label: "Read Code Starting At",
+    description: "First variable of a code written by Save Variable-Length Level Code",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE"
+  },
+  {
+    key: "resultVariable",
+    label: "Result Variable",
+    description: "Set to 1 if the code was loaded, 0 if it was made for a different level size",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE"
+  },
+  {
+    key: "description",
+    type: "label",
+    defaultValue: "Loads a variable-length level code and rebuilds the level."
+  }
+];
+
+const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, getVariableAlias } = helpers;
+
+  const variableAlias = getVariableAlias(input.variable);
+  const resultVariableAlias = getVariableAlias(input.resultVariable);
+
+  _stackPushConst(resultVariableAlias); // ARG1
+  _stackPushConst(variableAlias);       // ARG0
+
+  _callNative("vm_load_level_code_ext");
+  _stackPop(2);
+};
+
+module.exports = {
+  id,
+  name,
+  groups,
+  fields,
+  compile,
+  waitUntilAfterInitFade: true,
+};
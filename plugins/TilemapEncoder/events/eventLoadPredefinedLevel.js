@@ -15,6 +15,20 @@ const fields = [
       variable: "LAST_VARIABLE",
     },
   },
+  {
+    key: "sliced",
+    label: "Spread rebuild over several frames",
+    description: "Rebuild one block per step within the per-frame job budget instead of blocking",
+    type: "checkbox",
+    defaultValue: false,
+  },
+  {
+    key: "wait",
+    label: "Wait until finished",
+    type: "checkbox",
+    defaultValue: true,
+    conditions: [{ key: "sliced", eq: true }],
+  },
   {
     key: "description",
     type: "label",
@@ -23,7 +37,22 @@ const fields = [
 ];
 
 const compile = (input, helpers) => {
-  const { _callNative, _setConst, getVariableAlias } = helpers;
+  const { _callNative, _setConst, _stackPush, _stackPushConst, _stackPop, getVariableAlias } = helpers;
+  
+  if (input.sliced) {
+    // Level index is replaced by the job ID in the same slot
+    if (input.levelIndex.type === "number") {
+      _stackPushConst(input.levelIndex.value);
+    } else {
+      _stackPush(getVariableAlias(input.levelIndex.value));
+    }
+    _callNative("vm_load_predefined_level_job");
+    if (input.wait) {
+      _callNative("vm_job_wait");
+    }
+    _stackPop(1);
+    return;
+  }
   
   if (input.levelIndex.type === "number") {
     _setConst(".ARG0", input.levelIndex.value);
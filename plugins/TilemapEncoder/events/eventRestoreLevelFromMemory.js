@@ -3,6 +3,20 @@ const groups = ["EVENT_GROUP_MISC"];
 const name = "Restore Level from Memory";
 
 const fields = [
+  {
+    key: "sliced",
+    label: "Spread rebuild over several frames",
+    description: "Rebuild one block per step within the per-frame job budget instead of blocking",
+    type: "checkbox",
+    defaultValue: false,
+  },
+  {
+    key: "wait",
+    label: "Wait until finished",
+    type: "checkbox",
+    defaultValue: true,
+    conditions: [{ key: "sliced", eq: true }],
+  },
   {
     key: "description",
     type: "label",
@@ -11,7 +25,18 @@ const fields = [
 ];
 
 const compile = (input, helpers) => {
-  const { _callNative } = helpers;
+  const { _callNative, _stackPushConst, _stackPop } = helpers;
+  
+  if (input.sliced) {
+    // Job ID is written back into the pushed slot
+    _stackPushConst(0);
+    _callNative("vm_restore_level_from_memory_job");
+    if (input.wait) {
+      _callNative("vm_job_wait");
+    }
+    _stackPop(1);
+    return;
+  }
   
   _callNative("vm_restore_level_from_memory");
 };
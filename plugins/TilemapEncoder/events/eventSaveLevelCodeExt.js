@@ -0,0 +1,47 @@
+const id = "EVENT_SAVE_LEVEL_CODE_EXT";
+const groups = ["EVENT_GROUP_MISC"];
+const name = "Save Variable-Length Level Code";
+
+const fields = [
+  {
+    key: "variable",
+    label: "Store Code Starting At",
+    description: "Each code character is stored in this variable and the ones that follow it (up to 45)",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE"
+  },
+  {
+    key: "lengthVariable",
+    label: "Length Variable",
+    description: "Variable to store the number of characters written",
+    type: "variable",
+    defaultValue: "LAST_VARIABLE"
+  },
+  {
+    key: "description",
+    type: "label",
+    defaultValue: "Saves the current level as a variable-length level code. Unlike the 24-character code it covers levels of any width and every enemy slot."
+  }
+];
+
+const compile = (input, helpers) => {
+  const { _callNative, _stackPushConst, _stackPop, getVariableAlias } = helpers;
+
+  const variableAlias = getVariableAlias(input.variable);
+  const lengthVariableAlias = getVariableAlias(input.lengthVariable);
+
+  _stackPushConst(lengthVariableAlias); // ARG1
+  _stackPushConst(variableAlias);       // ARG0
+
+  _callNative("vm_save_level_code_ext");
+  _stackPop(2);
+};
+
+module.exports = {
+  id,
+  name,
+  groups,
+  fields,
+  compile,
+  waitUntilAfterInitFade: true,
+};
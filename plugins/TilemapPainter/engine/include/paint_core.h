@@ -19,8 +19,8 @@
 // Inline utility for repeated boundary checks
 UBYTE is_within_platform_bounds(UBYTE x, UBYTE y) BANKED;
 
-// Cached tile access to reduce repeated lookups
-UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED;
+// Cached tile access to reduce repeated lookups (home bank, callable without a far call)
+UBYTE get_current_tile_type(UBYTE x, UBYTE y) NONBANKED;
 
 // Convert subpixels
 #define TO_FP(n) ((INT16)((n) << 4))
@@ -3,33 +3,10 @@
 
 #include <gbdk/platform.h>
 
-// Metatile IDs
-#define TILE_EMPTY 0
-#define TILE_PLATFORM_LEFT 4
-#define TILE_PLATFORM_MIDDLE 5
-#define TILE_PLATFORM_RIGHT 6
-#define TILE_PLAYER 20
-#define TILE_RIGHT_ENEMY 21
-#define TILE_LEFT_ENEMY 22
-#define TILE_EXIT_TOP_LEFT 16
-#define TILE_EXIT_TOP_RIGHT 17
-#define TILE_EXIT_BOTTOM_LEFT 32
-#define TILE_EXIT_BOTTOM_RIGHT 33
-#define TILE_0 48
+// Metatile IDs, character tile range and brush tile types
+#include "level_tiles.h"
 
-// Character tile range constants for cycling
-#define TILE_CHAR_FIRST 48 // '0' at (0,3)
-#define TILE_CHAR_LAST 88  // Extended past 'Z' to cover all 41 positions (was 83)
-
-// Brush tile type constants
-#define BRUSH_TILE_EMPTY 0
-#define BRUSH_TILE_PLATFORM 1
-#define BRUSH_TILE_ENEMY_R 2
-#define BRUSH_TILE_ENEMY_L 3
-#define BRUSH_TILE_EXIT 4
-#define BRUSH_TILE_PLAYER 5
-#define BRUSH_TILE_OTHER 6
-
-UBYTE get_tile_type(UBYTE tile_id) BANKED;
+// Leaf query called per tile from every bank: kept in the home bank (no far call)
+UBYTE get_tile_type(UBYTE tile_id) NONBANKED;
 
 #endif
@@ -21,16 +21,16 @@ extern void reconstruct_tilemap_from_level_code(void) BANKED;
 extern void mark_display_position_for_update(UBYTE position) BANKED;
 extern void display_complete_level_code(void) BANKED;
 extern void display_selective_level_code_fast(void) BANKED;
-extern UBYTE extract_chunk_pattern(UBYTE x, UBYTE y) BANKED;
-extern UBYTE match_platform_pattern(UBYTE pattern) BANKED;
 extern UBYTE get_zone_index_from_tile(UBYTE x, UBYTE y) BANKED;
 extern void extract_player_data(void) BANKED;
 extern void extract_enemy_data(void) BANKED;
-extern void extract_platform_data(void) BANKED;
+extern void extract_platform_data_ext(void) BANKED;
 extern void update_valid_enemy_positions(void) BANKED;
 extern void save_level_code_to_variables(void) BANKED;
-extern UBYTE is_block_suppressed(UBYTE zone_index) BANKED;
-extern UBYTE get_suppress_display_updates(void) BANKED;
+extern void refresh_row_patterns_ext(UBYTE row_index) BANKED;
+extern void update_valid_enemy_positions_row(UBYTE row) BANKED;
+extern UBYTE suppressed_blocks[BLOCK_MASK_BYTES];
+extern UBYTE suppress_display_updates;
 extern void force_complete_level_code_display(void) BANKED;
 extern void init_enemy_system(void) BANKED;
 extern void update_valid_player_positions(void) BANKED;
@@ -54,7 +54,7 @@ UBYTE is_within_platform_bounds(UBYTE x, UBYTE y) BANKED
 }
 
 // Cached tile access to reduce repeated lookups
-UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED
+UBYTE get_current_tile_type(UBYTE x, UBYTE y) NONBANKED
 {
     return get_tile_type(sram_map_data[METATILE_MAP_OFFSET(x, y)]);
 }
@@ -65,8 +65,8 @@ UBYTE get_current_tile_type(UBYTE x, UBYTE y) BANKED
 
 void paint(UBYTE x, UBYTE y) BANKED
 {
-    // Player placement on row 11
-    if (y == 11)
+    // Player placement on PLAYER_ROW
+    if (y == PLAYER_ROW)
     {
         paint_player(x, y);
         return;
@@ -94,7 +94,7 @@ void paint(UBYTE x, UBYTE y) BANKED
 
     // New enemy placement - cycle through valid positions if needed
     // Only try to place an enemy if in a valid row for enemies
-    if (y == 12 || y == 14 || y == 16 || y == 18)
+    if (IS_ENEMY_ROW(y))
     {
         paint_enemy_right(x, y);
         // Don't return here - continue to check for platform placement
@@ -177,8 +177,8 @@ void paint(UBYTE x, UBYTE y) BANKED
 
 void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
 {
-    // For player painting (row 11), update enemy/player data
-    if (y == 11)
+    // For player painting (PLAYER_ROW), update enemy/player data
+    if (y == PLAYER_ROW)
     {
         // Extract player data
         extract_player_data();
@@ -187,7 +187,7 @@ void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
         update_valid_enemy_positions();
 
         // Mark enemy/player data positions for update (positions 16-23)
-        for (UBYTE i = 16; i < 24; i++)
+        for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
             mark_display_position_for_update(i);
         }
@@ -196,8 +196,8 @@ void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
     }
 
     // For enemy operations on enemy rows, update enemy data
-    // Enemy rows are 12, 14, 16, 18 (PLATFORM_Y_MIN + row * SEGMENT_HEIGHT)
-    if (y == 12 || y == 14 || y == 16 || y == 18)
+    // Enemy rows are PLATFORM_Y_MIN + row * SEGMENT_HEIGHT
+    if (IS_ENEMY_ROW(y))
     {
         // For any operation on enemy rows, extract enemy data and update display
         // This handles both enemy placement and other operations on enemy rows
@@ -205,7 +205,7 @@ void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
         extract_player_data(); // Player data might have changed too
 
         // Mark enemy/player data positions for update (positions 16-23)
-        for (UBYTE i = 16; i < 24; i++)
+        for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
             mark_display_position_for_update(i);
         }
@@ -213,22 +213,33 @@ void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
         return;
     }
 
-    // For platform operations, update valid enemy positions
-    UBYTE current_tile_type = get_current_tile_type(x, y);
-    if (current_tile_type == BRUSH_TILE_PLATFORM ||
-        y == 13 || y == 15 || y == 17 || y == 19) // Platform rows
+    // Platform rows: an edit (including auto-completion) only changes its own segment row,
+    // so only that row's patterns and enemy anchors are rebuilt
+    if (IS_PLATFORM_ROW(y) && IS_LEVEL_COLUMN(x))
     {
-        // Update platform data
-        extract_platform_data();
+        UBYTE row_index = SEGMENT_ROW_OF(y);
 
-        // Update valid enemy positions - platforms affect where enemies can be placed
-        update_valid_enemy_positions();
+        // Extract the patterns of the row in one call (skips suppressed blocks)
+        refresh_row_patterns_ext(row_index);
 
-        // Update enemy data in case enemies were removed when deleting platforms
-        // extract_enemy_data(); // No longer needed - enemy data is managed directly
+        // Platforms decide where the player and enemies can stand
+        update_valid_player_positions();
+        update_valid_enemy_positions_row(row_index);
 
-        // Mark platform and enemy data for update
-        for (UBYTE i = 0; i < 24; i++)
+        // Check if display updates are suppressed (during programmatic painting)
+        if (suppress_display_updates)
+        {
+            return;
+        }
+
+        // Mark the row's unsuppressed blocks plus player/enemy data for update
+        UBYTE zone_index = row_index * SEGMENTS_PER_ROW;
+        for (UBYTE col = 0; col < SEGMENTS_PER_ROW; col++, zone_index++)
+        {
+            if (!BLOCK_MASK_TEST(suppressed_blocks, zone_index))
+                mark_display_position_for_update(zone_index);
+        }
+        for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
             mark_display_position_for_update(i);
         }
@@ -236,51 +247,26 @@ void update_level_code_for_paint(UBYTE x, UBYTE y) BANKED
         return;
     }
 
-    // For platform operations, update affected zones
-    if (y >= PLATFORM_Y_MIN && y <= PLATFORM_Y_MAX &&
-        x >= PLATFORM_X_MIN && x <= PLATFORM_X_MAX &&
-        is_valid_platform_row(y))
+    // Platform tile outside the segment grid: rebuild every row
+    if (get_current_tile_type(x, y) == BRUSH_TILE_PLATFORM)
     {
-        // Check if pattern updates are suppressed (during programmatic painting)
-        if (get_suppress_display_updates())
-        {
-            return; // Skip pattern updates during programmatic painting
-        }
-
-        // Platform operations can affect multiple zones on the same row due to auto-completion
-        // Update all zones on this row to be safe
-        UBYTE row_index = (y - PLATFORM_Y_MIN) / SEGMENT_HEIGHT;
-
-        for (UBYTE col = 0; col < SEGMENTS_PER_ROW; col++)
-        {
-            UBYTE zone_index = row_index * SEGMENTS_PER_ROW + col;
-
-            // CRITICAL: Check if this specific block is suppressed
-            if (is_block_suppressed(zone_index))
-                continue;
-
-            // Extract the current pattern for this zone
-            UBYTE segment_x = 2 + col * SEGMENT_WIDTH;
-            UBYTE segment_y = PLATFORM_Y_MIN + row_index * SEGMENT_HEIGHT;
-
-            // Get the pattern and update the level code
-            UBYTE pattern = extract_chunk_pattern(segment_x, segment_y);
-            current_level_code.platform_patterns[zone_index] = match_platform_pattern(pattern);
+        // Update platform data
+        extract_platform_data_ext();
 
-            // Mark this position for display update
-            mark_display_position_for_update(zone_index);
-        }
+        // Update valid enemy positions - platforms affect where enemies can be placed
+        update_valid_enemy_positions();
 
-        // Use fast selective update (only if display updates are not suppressed)
-        if (!get_suppress_display_updates())
+        // Mark platform and enemy data for update
+        for (UBYTE i = 0; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
-            display_selective_level_code_fast();
+            mark_display_position_for_update(i);
         }
+        display_selective_level_code_fast();
         return;
     }
 
     // Check if display updates are globally suppressed (during pattern application)
-    if (get_suppress_display_updates())
+    if (suppress_display_updates)
     {
         return; // Skip display updates during pattern application
     }
@@ -311,7 +297,7 @@ UBYTE is_map_empty(void) BANKED
     // Check for player tile
     for (UBYTE x = PLATFORM_X_MIN; x <= PLATFORM_X_MAX; x++)
     {
-        if (get_current_tile_type(x, 11) == BRUSH_TILE_PLAYER)
+        if (get_current_tile_type(x, PLAYER_ROW) == BRUSH_TILE_PLAYER)
         {
             return 0; // Found player, map is not empty
         }
@@ -364,12 +350,12 @@ void init_default_level_code(void) BANKED
     reconstruct_tilemap_from_level_code();
 
     // Place the player
-    UBYTE player_x = current_level_code.player_column + 2; // Convert to tile coordinates
-    replace_meta_tile(player_x, 11, TILE_PLAYER, 1);
-    move_player_actor_to_tile(paint_player_id, player_x, 11);
+    UBYTE player_x = current_level_code.player_column + PLATFORM_X_MIN; // Convert to tile coordinates
+    replace_meta_tile(player_x, PLAYER_ROW, TILE_PLAYER, 1);
+    move_player_actor_to_tile(paint_player_id, player_x, PLAYER_ROW);
 
     // Position the exit sprite
-    position_exit_for_player(player_x, 11);
+    position_exit_for_player(player_x, PLAYER_ROW);
 
     // Update the level code display
     force_complete_level_code_display();
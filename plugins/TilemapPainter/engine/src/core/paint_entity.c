@@ -94,7 +94,7 @@ UBYTE count_enemies_on_map(void) BANKED
 
 UBYTE can_paint_player(UBYTE x, UBYTE y) BANKED
 {
-    return (y == 11 &&
+    return (y == PLAYER_ROW &&
             x >= PLATFORM_X_MIN && x <= PLATFORM_X_MAX &&
             has_platform_below(x, y) &&      // Must have platform below
             !has_enemy_below_player(x, y) && // Can't place player above enemies
@@ -115,13 +115,10 @@ void find_next_valid_enemy_position(UBYTE *x, UBYTE *y) BANKED
     UBYTE start_y = *y;
     UBYTE found = 0;
 
-    // Check all standard enemy rows (these match ENEMY_ROWS in validation.c)
-    static const UBYTE enemy_rows[4] = {12, 14, 16, 18};
-
     // Check all standard enemy rows
-    for (UBYTE row_index = 0; row_index < 4; row_index++)
+    for (UBYTE row_index = 0; row_index < SEGMENT_ROWS; row_index++)
     {
-        UBYTE check_y = enemy_rows[row_index];
+        UBYTE check_y = ENEMY_ROW_Y(row_index);
 
         // On the current row, start from the next column
         UBYTE start_col = (check_y == start_y) ? start_x + 1 : PLATFORM_X_MIN;
@@ -143,9 +140,9 @@ void find_next_valid_enemy_position(UBYTE *x, UBYTE *y) BANKED
     // start over from the beginning
     if (!found)
     {
-        for (UBYTE row_index = 0; row_index < 4; row_index++)
+        for (UBYTE row_index = 0; row_index < SEGMENT_ROWS; row_index++)
         {
-            UBYTE check_y = enemy_rows[row_index];
+            UBYTE check_y = ENEMY_ROW_Y(row_index);
 
             for (UBYTE check_x = PLATFORM_X_MIN; check_x <= PLATFORM_X_MAX; check_x++)
             {
@@ -282,9 +279,9 @@ void clear_existing_player_on_row_11(void) BANKED
 {
     for (UBYTE x = PLATFORM_X_MIN; x <= PLATFORM_X_MAX; x++)
     {
-        if (get_current_tile_type(x, 11) == BRUSH_TILE_PLAYER)
+        if (get_current_tile_type(x, PLAYER_ROW) == BRUSH_TILE_PLAYER)
         {
-            replace_meta_tile(x, 11, TILE_EMPTY, 1);
+            replace_meta_tile(x, PLAYER_ROW, TILE_EMPTY, 1);
         }
     }
 }
@@ -292,22 +289,13 @@ void clear_existing_player_on_row_11(void) BANKED
 void remove_enemies_above_platform(UBYTE x, UBYTE y) BANKED
 {
     // Find the corresponding enemy row for this platform
-    // Platforms are at rows 13, 15, 17, 19, and enemies are at rows 12, 14, 16, 18
-    UBYTE enemy_row = 255;
-
-    if (y == 13)
-        enemy_row = 12;
-    else if (y == 15)
-        enemy_row = 14;
-    else if (y == 17)
-        enemy_row = 16;
-    else if (y == 19)
-        enemy_row = 18;
-
+    // Each platform row sits one row below the enemy row of its segment row
     // If this isn't a platform row that would affect enemies, exit
-    if (enemy_row == 255)
+    if (!IS_PLATFORM_ROW(y))
         return;
 
+    UBYTE enemy_row = ENEMY_ROW_Y(SEGMENT_ROW_OF(y));
+
     // Check if there's an enemy actor at this position and remove it
     UBYTE found_enemy = 0;
     for (UBYTE i = 0; i < MAX_PAINT_ENEMIES; i++)
@@ -341,7 +329,7 @@ void remove_enemies_above_platform(UBYTE x, UBYTE y) BANKED
         remove_enemy_from_level_code(x, enemy_row);
         
         // Mark enemy positions for display update
-        for (UBYTE i = 16; i < 24; i++)
+        for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
             mark_display_position_for_update(i);
         }
@@ -367,7 +355,7 @@ void paint_player(UBYTE x, UBYTE y) BANKED
 
     // --- Ensure level code and display are updated after painting the player ---
     extract_player_data();
-    mark_display_position_for_update(16); // Mark char 16 for display update
+    mark_display_position_for_update(LEVEL_CODE_PLAYER_INDEX); // Mark char 16 for display update
     display_selective_level_code_fast();
 }
 
@@ -436,7 +424,7 @@ void paint_enemy_right(UBYTE x, UBYTE y) BANKED
     }
     
     // Mark enemy positions for display update
-    for (UBYTE i = 16; i < 24; i++)
+    for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         mark_display_position_for_update(i);
     }
@@ -510,7 +498,7 @@ void paint_enemy_left(UBYTE x, UBYTE y) BANKED
     }
     
     // Mark enemy positions for display update
-    for (UBYTE i = 16; i < 24; i++)
+    for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
     {
         mark_display_position_for_update(i);
     }
@@ -554,7 +542,7 @@ void delete_enemy(UBYTE x, UBYTE y) BANKED
         remove_enemy_from_level_code(x, y);
         
         // Mark enemy positions for display update
-        for (UBYTE i = 16; i < 24; i++)
+        for (UBYTE i = LEVEL_CODE_PLAYER_INDEX; i < LEVEL_CODE_CHARS_TOTAL; i++)
         {
             mark_display_position_for_update(i);
         }
@@ -628,7 +616,7 @@ void clear_existing_exit_tiles(void) BANKED
 // DIRECT LEVEL CODE UPDATE FOR ENEMY PAINTING
 // ============================================================================
 
-#define LEVEL_CODE_MAX_ENEMIES 5 // Must match the level code structure limit
+#define LEVEL_CODE_MAX_ENEMIES LEVEL_CODE_ENEMY_POSITIONS // Must match the level code structure limit
 
 // Convert tilemap coordinates to enemy position in level code
 void add_enemy_to_level_code(UBYTE x, UBYTE y, UBYTE direction) BANKED
@@ -637,15 +625,12 @@ void add_enemy_to_level_code(UBYTE x, UBYTE y, UBYTE direction) BANKED
     if (x < PLATFORM_X_MIN || x > PLATFORM_X_MAX)
         return;
     
-    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-19 range
-    UBYTE row = 255; // Invalid row by default
+    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-(PLATFORM_COLUMNS - 1) range
     
     // Determine which enemy row this corresponds to
-    if (y == 12) row = 0;
-    else if (y == 14) row = 1;  
-    else if (y == 16) row = 2;
-    else if (y == 18) row = 3;
-    else return; // Not a valid enemy row
+    if (!IS_ENEMY_ROW(y))
+        return; // Not a valid enemy row
+    UBYTE row = SEGMENT_ROW_OF(y);
     
     // Find an empty enemy slot (only use first 5 slots to match level code)
     UBYTE enemy_slot = 255;
@@ -683,15 +668,12 @@ void remove_enemy_from_level_code(UBYTE x, UBYTE y) BANKED
     if (x < PLATFORM_X_MIN || x > PLATFORM_X_MAX)
         return;
     
-    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-19 range
-    UBYTE row = 255; // Invalid row by default
+    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-(PLATFORM_COLUMNS - 1) range
     
     // Determine which enemy row this corresponds to
-    if (y == 12) row = 0;
-    else if (y == 14) row = 1;
-    else if (y == 16) row = 2;
-    else if (y == 18) row = 3;
-    else return; // Not a valid enemy row
+    if (!IS_ENEMY_ROW(y))
+        return; // Not a valid enemy row
+    UBYTE row = SEGMENT_ROW_OF(y);
     
     // Find and remove enemy at this position (only check first 5 slots)
     for (UBYTE i = 0; i < LEVEL_CODE_MAX_ENEMIES; i++)
@@ -715,15 +697,12 @@ void update_enemy_direction_in_level_code(UBYTE x, UBYTE y, UBYTE direction) BAN
     if (x < PLATFORM_X_MIN || x > PLATFORM_X_MAX)
         return;
     
-    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-19 range
-    UBYTE row = 255; // Invalid row by default
+    UBYTE col = x - PLATFORM_X_MIN; // Convert to 0-(PLATFORM_COLUMNS - 1) range
     
     // Determine which enemy row this corresponds to
-    if (y == 12) row = 0;
-    else if (y == 14) row = 1;
-    else if (y == 16) row = 2;
-    else if (y == 18) row = 3;
-    else return; // Not a valid enemy row
+    if (!IS_ENEMY_ROW(y))
+        return; // Not a valid enemy row
+    UBYTE row = SEGMENT_ROW_OF(y);
     
     // Find and update enemy direction at this position (only check first 5 slots)
     for (UBYTE i = 0; i < LEVEL_CODE_MAX_ENEMIES; i++)
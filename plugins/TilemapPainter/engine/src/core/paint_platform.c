@@ -20,7 +20,7 @@ extern void update_column_platform_painted(UBYTE x, UBYTE y) BANKED;
 
 UBYTE is_valid_platform_row(UBYTE y) BANKED
 {
-    return (y == 13 || y == 15 || y == 17 || y == 19);
+    return IS_PLATFORM_ROW(y);
 }
 
 UBYTE has_platform_below(UBYTE x, UBYTE y) BANKED
@@ -8,6 +8,7 @@
 #include "paint_entity.h"
 #include "meta_tiles.h"
 #include "tile_utils.h"
+#include "level_format.h"
 
 // ============================================================================
 // BRUSH STATE FUNCTIONS
@@ -45,7 +46,7 @@ UBYTE get_brush_tile_state(UBYTE x, UBYTE y) BANKED
     switch (current_tile_type)
     {
     case BRUSH_TILE_EMPTY:
-        if (y == 11)
+        if (y == PLAYER_ROW)
         {
             return can_paint_player(x, y) ? SELECTOR_STATE_PLAYER : SELECTOR_STATE_DEFAULT;
         }
@@ -59,7 +60,7 @@ UBYTE get_brush_tile_state(UBYTE x, UBYTE y) BANKED
         return SELECTOR_STATE_DELETE;
 
     case BRUSH_TILE_PLAYER:
-        return (y == 11) ? SELECTOR_STATE_DEFAULT : SELECTOR_STATE_PLAYER;
+        return (y == PLAYER_ROW) ? SELECTOR_STATE_DEFAULT : SELECTOR_STATE_PLAYER;
 
     case BRUSH_TILE_EXIT:
     default:
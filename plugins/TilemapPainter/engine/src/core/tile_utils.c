@@ -2,7 +2,7 @@
 
 #include "tile_utils.h"
 
-UBYTE get_tile_type(UBYTE tile_id) BANKED
+UBYTE get_tile_type(UBYTE tile_id) NONBANKED
 {
     switch (tile_id)
     {
@@ -17,7 +17,22 @@ export const fields = [
   },
 ];
 
+// Number or variable X/Y are folded into one batched native call by the
+// Call Native Functions (Batched) event from EngineCorePlugin, instead of
+// being copied to locals and pushed
+const isFoldable = (value) => value && (value.type === "number" || value.type === "variable");
+
 export const compile = (input, helpers) => {
+  if (isFoldable(input.x) && isFoldable(input.y)) {
+    helpers.compileEvents([
+      {
+        command: "EVENT_CALL_NATIVE_BATCH",
+        args: { calls: 1, fn1: "vm_paint", argc1: 2, arg1_0: input.x, arg1_1: input.y },
+      },
+    ]);
+    return;
+  }
+
   const {
     _declareLocal,
     variableSetToScriptValue,
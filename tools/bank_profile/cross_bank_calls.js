@@ -0,0 +1,200 @@
+#!/usr/bin/env node
+// Static cross-bank call profiler for the plugin engine code.
+//
+//   node tools/bank_profile/cross_bank_calls.js                 edge summary
+//   node tools/bank_profile/cross_bank_calls.js --root paint    calls reachable from paint()
+//   node tools/bank_profile/cross_bank_calls.js --json          machine readable output
+//
+// Every plugins/*/engine/src/**/*.c file is scanned for its `#pragma bank`
+// and the functions it defines. A call is counted as a bank switch when the
+// callee is declared BANKED and lives in a different bank than the caller, or
+// either side is autobanked (255), since the linker may place them apart.
+// Unqualified functions are near calls within their bank, and a file always
+// shares one bank, so NONBANKED and unqualified callees, same-file callees
+// and header inlines never switch banks. Calls inside loops are weighted by
+// LOOP_WEIGHT to approximate their share of the dynamic count.
+
+const fs = require("fs");
+const path = require("path");
+
+const ROOT = path.resolve(__dirname, "..", "..");
+const PLUGINS = path.join(ROOT, "plugins");
+const AUTOBANK = 255;
+const LOOP_WEIGHT = 8;
+
+const KEYWORDS = new Set([
+  "if", "for", "while", "switch", "return", "sizeof", "else", "do", "case",
+]);
+
+const walk = (dir, out = []) => {
+  for (const entry of fs.readdirSync(dir, { withFileTypes: true })) {
+    const full = path.join(dir, entry.name);
+    if (entry.isDirectory()) walk(full, out);
+    else if (entry.name.endsWith(".c")) out.push(full);
+  }
+  return out;
+};
+
+// Remove comments and string literals, keeping line structure
+const strip = (src) =>
+  src
+    .replace(/\/\*[\s\S]*?\*\//g, (m) => m.replace(/[^\n]/g, " "))
+    .replace(/\/\/.*$/gm, "")
+    .replace(/"(?:\\.|[^"\\])*"/g, '""');
+
+// Find top level function definitions and their bodies
+const parseFunctions = (src) => {
+  const fns = [];
+  const head = /(^|\n)[A-Za-z_][\w\s\*]*?\b([A-Za-z_]\w*)\s*\(([^;{)]*)\)\s*((?:OLDCALL|BANKED|NONBANKED|NAKED|CRITICAL|\s)*)\{/g;
+  let m;
+  while ((m = head.exec(src))) {
+    const name = m[2];
+    if (KEYWORDS.has(name)) continue;
+    let depth = 1;
+    let i = head.lastIndex;
+    for (; i < src.length && depth; i++) {
+      if (src[i] === "{") depth++;
+      else if (src[i] === "}") depth--;
+    }
+    fns.push({
+      name,
+      banked: /\bBANKED\b/.test(m[4]) && !/NONBANKED/.test(m[4]),
+      home: /NONBANKED/.test(m[4]),
+      local: /\bstatic\b/.test(m[0]),
+      body: src.slice(head.lastIndex, i - 1),
+    });
+    head.lastIndex = i;
+  }
+  return fns;
+};
+
+// Mark which body offsets sit inside a for/while/do loop
+const loopMask = (body) => {
+  const mask = new Uint8Array(body.length);
+  const loop = /\b(for|while|do)\b/g;
+  let m;
+  while ((m = loop.exec(body))) {
+    const open = body.indexOf("{", m.index);
+    const semi = body.indexOf(";", m.index);
+    if (open < 0 || (m[1] === "while" && semi >= 0 && semi < open)) continue;
+    let depth = 1;
+    let i = open + 1;
+    for (; i < body.length && depth; i++) {
+      if (body[i] === "{") depth++;
+      else if (body[i] === "}") depth--;
+    }
+    mask.fill(1, open, i);
+  }
+  return mask;
+};
+
+// Definitions by name; file-static helpers may share a name across files
+const load = () => {
+  const defs = new Map();
+  for (const file of walk(PLUGINS)) {
+    if (!file.includes(`${path.sep}engine${path.sep}src${path.sep}`)) continue;
+    const src = strip(fs.readFileSync(file, "utf8"));
+    const pragma = src.match(/#pragma\s+bank\s+(\d+)/);
+    const bank = pragma ? Number(pragma[1]) : 0;
+    for (const fn of parseFunctions(src)) {
+      if (!defs.has(fn.name)) defs.set(fn.name, []);
+      defs.get(fn.name).push({ ...fn, bank, file: path.relative(ROOT, file) });
+    }
+  }
+  return defs;
+};
+
+// The definition a call resolves to: the caller's own file first, then a
+// non-static definition elsewhere
+const resolve = (defs, caller, name) => {
+  const list = defs.get(name);
+  if (!list) return null;
+  return list.find((d) => d.file === caller.file) || list.find((d) => !d.local) || null;
+};
+
+const switches = (caller, callee) =>
+  callee.banked &&
+  caller.file !== callee.file &&
+  (caller.bank !== callee.bank || caller.bank === AUTOBANK || callee.bank === AUTOBANK);
+
+const collectEdges = (defs) => {
+  const edges = [];
+  for (const caller of [...defs.values()].flat()) {
+    const mask = loopMask(caller.body);
+    const call = /\b([A-Za-z_]\w*)\s*\(/g;
+    let m;
+    while ((m = call.exec(caller.body))) {
+      const callee = resolve(defs, caller, m[1]);
+      if (!callee || callee === caller) continue;
+      edges.push({
+        caller: caller.name,
+        callee: callee.name,
+        from: caller.bank,
+        to: callee.home ? "home" : callee.bank,
+        cross: switches(caller, callee),
+        weight: mask[m.index] ? LOOP_WEIGHT : 1,
+      });
+    }
+  }
+  return edges;
+};
+
+const reachable = (edges, root) => {
+  const out = new Map();
+  edges.forEach((e) => {
+    if (!out.has(e.caller)) out.set(e.caller, []);
+    out.get(e.caller).push(e);
+  });
+  const seen = new Set([root]);
+  const queue = [root];
+  const result = [];
+  while (queue.length) {
+    const fn = queue.shift();
+    for (const e of out.get(fn) || []) {
+      result.push(e);
+      if (!seen.has(e.callee)) seen.add(e.callee), queue.push(e.callee);
+    }
+  }
+  return result;
+};
+
+const summarize = (edges) => {
+  const byEdge = new Map();
+  for (const e of edges) {
+    if (!e.cross) continue;
+    const key = `${e.caller} -> ${e.callee}`;
+    const row = byEdge.get(key) || { ...e, sites: 0, score: 0 };
+    row.sites++;
+    row.score += e.weight;
+    byEdge.set(key, row);
+  }
+  return [...byEdge.values()].sort((a, b) => b.score - a.score);
+};
+
+const main = () => {
+  const args = process.argv.slice(2);
+  const rootIdx = args.indexOf("--root");
+  const root = rootIdx >= 0 ? args[rootIdx + 1] : null;
+  const defs = load();
+  if (root && !defs.has(root)) {
+    console.error(`cross_bank_calls: unknown function ${root}`);
+    process.exit(1);
+  }
+  let edges = collectEdges(defs);
+  if (root) edges = reachable(edges, root);
+  const rows = summarize(edges);
+
+  if (args.includes("--json")) {
+    console.log(JSON.stringify(rows, null, 2));
+    return;
+  }
+  const total = rows.reduce((n, r) => n + r.score, 0);
+  console.log(`${rows.length} cross-bank call edges${root ? ` reachable from ${root}()` : ""}, weighted score ${total}`);
+  console.log("score  sites  banks      edge");
+  for (const r of rows) {
+    const banks = `${r.from}->${r.to}`.padEnd(10);
+    console.log(`${String(r.score).padStart(5)}  ${String(r.sites).padStart(5)}  ${banks} ${r.caller} -> ${r.callee}`);
+  }
+};
+
+main();
@@ -0,0 +1,344 @@
+#!/usr/bin/env node
+// Generates the level format headers for the TilemapEncoder and TilemapPainter
+// plugins from level_format.json.
+//
+//   node tools/level_format/gen_level_format.js          write the headers
+//   node tools/level_format/gen_level_format.js --check  fail if they are stale
+//
+// level_tiles.h  - metatile IDs, brush types, character tile range (tile_utils.h)
+// level_format.h - geometry, row tests, level code layouts and pattern tables
+//                  (code_level_core.h)
+//
+// Tables are emitted as initializer macros rather than definitions so each
+// plugin keeps its arrays in the ROM bank of the code that reads them.
+
+const fs = require("fs");
+const path = require("path");
+
+const ROOT = path.resolve(__dirname, "..", "..");
+const SPEC = path.join(__dirname, "level_format.json");
+const PLUGINS = ["plugins/TilemapEncoder", "plugins/TilemapPainter"];
+
+const PATTERN_NONE = 0xff;
+const CODE_CHARS_PER_ROW = 12;
+
+const HEADER = [
+  "// GENERATED by tools/level_format/gen_level_format.js from level_format.json",
+  "// Do not edit by hand: change the spec and rerun the generator.",
+  "",
+];
+
+const SECTION = (title) => [
+  "// ============================================================================",
+  `// ${title}`,
+  "// ============================================================================",
+  "",
+];
+
+const fail = (msg) => {
+  console.error(`gen_level_format: ${msg}`);
+  process.exit(1);
+};
+
+const hex = (n) => `0x${n.toString(16).padStart(2, "0").toUpperCase()}`;
+
+// Wrap a list of numbers into an initializer macro, 10 values per line
+const initMacro = (name, values, fmt = String) => {
+  const rows = [];
+  for (let i = 0; i < values.length; i += 10) {
+    rows.push("    " + values.slice(i, i + 10).map(fmt).join(", "));
+  }
+  return `#define ${name} { \\\n${rows.join(", \\\n")} \\\n}`;
+};
+
+const defines = (group) =>
+  Object.entries(group).map(([key, value]) => `#define ${key} ${value}`);
+
+const charTiles = (spec, count) =>
+  Array.from({ length: count }, (_, v) => spec.chars.tile_base + v);
+
+const buildTiles = (spec) => {
+  const c = spec.chars;
+  return [
+    ...HEADER,
+    "#ifndef LEVEL_TILES_H",
+    "#define LEVEL_TILES_H",
+    "",
+    ...SECTION("METATILES"),
+    ...defines(spec.tiles),
+    `#define TILE_0 ${c.tile_base}`,
+    "",
+    "// Brush tile type constants",
+    ...defines(spec.brush),
+    "",
+    ...SECTION("CHARACTER TILES"),
+    "// Every code value v is drawn with metatile CHAR_TILE_BASE + v",
+    `#define CHAR_TILE_BASE ${c.tile_base}`,
+    `#define POS41_VALUE_COUNT ${c.pos41_values}`,
+    `#define BASE32_VALUE_COUNT ${c.base32_values}`,
+    `#define CHAR_VALUE_EXTENDED_MAX ${c.extended_max}`,
+    "",
+    "// Character tile range constants for cycling",
+    `#define TILE_CHAR_FIRST ${c.tile_base}`,
+    `#define TILE_CHAR_LAST ${c.tile_base + c.pos41_values - 1}`,
+    "",
+    "#endif // LEVEL_TILES_H",
+    "",
+  ].join("\n");
+};
+
+const buildFormat = (spec) => {
+  const g = spec.geometry;
+  const width = g.SEGMENT_WIDTH;
+  const columns = g.SEGMENTS_PER_ROW;
+  const edge = 1 << (width - 1);
+
+  // Derived geometry
+  const levelColumns = columns * width;
+  const levelRows = g.SEGMENT_ROWS * g.SEGMENT_HEIGHT;
+  const xMax = g.PLATFORM_X_MIN + levelColumns - 1;
+  const yMax = g.PLATFORM_Y_MIN + levelRows - 1;
+  const totalBlocks = columns * g.SEGMENT_ROWS;
+  const enemyRows = [];
+  const platformRows = [];
+  for (let r = 0; r < g.SEGMENT_ROWS; r++) {
+    const top = g.PLATFORM_Y_MIN + r * g.SEGMENT_HEIGHT;
+    enemyRows.push(top);
+    platformRows.push(top + g.SEGMENT_HEIGHT - 1);
+  }
+
+  // Limits of the C side: UBYTE tile coordinates, block indices and job
+  // steps, one UBYTE bit per enemy and per pattern tile
+  if (width < 2 || width > 8) fail("SEGMENT_WIDTH must be 2-8");
+  if (g.SEGMENT_HEIGHT < 2) fail("SEGMENT_HEIGHT must leave an enemy row above the platform row");
+  if (g.PLATFORM_Y_MIN < 1) fail("PLATFORM_Y_MIN must leave a player row above the level");
+  if (xMax > 255 || yMax > 255) fail("level does not fit UBYTE tile coordinates");
+  if (levelColumns > 127) fail("level columns must fit the signed BYTE column loops");
+  if (totalBlocks * 2 + 2 > 255) fail("too many blocks for a UBYTE rebuild job step");
+  if (g.MAX_ENEMIES > 8) fail("MAX_ENEMIES must fit the UBYTE direction mask");
+
+  // Fixed 24 character code: 16 pattern chars, player column and enemy
+  // anchors (two columns each) as POS41 values, 5 enemies in the masks
+  const anchorsPerRow = Math.ceil(levelColumns / 2);
+  const enemyPosMax = g.SEGMENT_ROWS * anchorsPerRow;
+  const posMax = spec.chars.pos41_values - 1;
+  const codeEnemyPositions = spec.level_code.LEVEL_CODE_ENEMY_POSITIONS;
+  const codeEnemyIndex = totalBlocks + 1;
+  const codeCharsTotal = codeEnemyIndex + codeEnemyPositions + 2;
+  const legacy =
+    totalBlocks === 16 && levelColumns <= posMax && enemyPosMax <= posMax ? 1 : 0;
+
+  // Variable-length code: header, patterns, player, enemy count, then
+  // only the placed enemies
+  const extHeader = 2;
+  const extPlayerChars = 2;
+  const extEnemyChars = 4;
+  const extMax = extHeader + totalBlocks + extPlayerChars + 1 + g.MAX_ENEMIES * extEnemyChars;
+  if (columns >= spec.chars.base32_values || g.SEGMENT_ROWS >= spec.chars.base32_values) {
+    fail("segment counts must fit one BASE32 header character");
+  }
+
+  // Patterns: bit (width - 1) is the leftmost tile, bit 0 the rightmost
+  const patterns = spec.platform_patterns.map((p, i) => {
+    if (p.bits.length !== width || /[^01]/.test(p.bits)) {
+      fail(`pattern ${i} "${p.bits}" is not ${width} bits`);
+    }
+    return parseInt(p.bits, 2);
+  });
+  if (patterns.length >= PATTERN_NONE) fail("too many patterns");
+  if (patterns.length > spec.chars.pattern_chars) fail("more patterns than pattern characters");
+
+  const fromBits = new Array(1 << width).fill(PATTERN_NONE);
+  patterns.forEach((bits, i) => {
+    if (fromBits[bits] !== PATTERN_NONE) fail(`pattern ${i} duplicates pattern ${fromBits[bits]}`);
+    fromBits[bits] = i;
+  });
+
+  // A platform tile alone on a block edge spills into the neighbouring block,
+  // so it is only valid where that neighbour exists
+  const leftSpill = (bits) => (bits & edge) && !(bits & (edge >> 1));
+  const rightSpill = (bits) => (bits & 1) && !(bits & 2);
+  const edgeFlags = patterns.map(
+    (bits) => (leftSpill(bits) ? 1 : 0) | (rightSpill(bits) ? 2 : 0)
+  );
+  const invalidFirst = patterns.flatMap((bits, i) => (leftSpill(bits) ? [i] : []));
+  const invalidLast = patterns.flatMap((bits, i) => (rightSpill(bits) ? [i] : []));
+
+  // Predefined fixed codes: a short row would silently zero-fill in C
+  const levels = spec.predefined_levels || [];
+  levels.forEach((level, n) => {
+    if (level.chars.length !== codeCharsTotal) {
+      fail(`predefined level ${n} has ${level.chars.length} chars, the fixed code has ${codeCharsTotal}`);
+    }
+    if (level.chars.some((v) => !Number.isInteger(v) || v < 0 || v > posMax)) {
+      fail(`predefined level ${n} has a value outside 0-${posMax}`);
+    }
+    if (level.chars.slice(0, totalBlocks).some((v) => v >= patterns.length)) {
+      fail(`predefined level ${n} uses an unknown pattern`);
+    }
+  });
+  const predefinedRows = levels.map(
+    (level) => `    /* ${level.comment} */ \\\n    {{ ${level.chars.join(", ")} }}`
+  );
+
+  return [
+    ...HEADER,
+    "#ifndef LEVEL_FORMAT_H",
+    "#define LEVEL_FORMAT_H",
+    "",
+    '#include "data/states_defines.h"',
+    '#include "level_tiles.h"',
+    "",
+    ...SECTION("LEVEL GEOMETRY"),
+    `#define PLATFORM_Y_MIN ${g.PLATFORM_Y_MIN}`,
+    `#define PLATFORM_Y_MAX ${yMax}`,
+    `#define PLATFORM_X_MIN ${g.PLATFORM_X_MIN}`,
+    `#define PLATFORM_X_MAX ${xMax}`,
+    `#define SEGMENTS_PER_ROW ${columns}`,
+    `#define SEGMENT_ROWS ${g.SEGMENT_ROWS}`,
+    `#define SEGMENT_WIDTH ${width}`,
+    `#define SEGMENT_HEIGHT ${g.SEGMENT_HEIGHT}`,
+    `#define TOTAL_BLOCKS ${totalBlocks}`,
+    "",
+    "// Level columns (player and enemy positions are 0-based within these)",
+    `#define PLATFORM_COLUMNS ${levelColumns}`,
+    "// The player stands on the row directly above the level",
+    `#define PLAYER_ROW ${g.PLATFORM_Y_MIN - 1}`,
+    "// Bytes in a one-bit-per-block mask",
+    `#define BLOCK_MASK_BYTES ${Math.ceil(totalBlocks / 8)}`,
+    "",
+    `#define MAX_ENEMIES ${g.MAX_ENEMIES} // Maximum number of enemy actors supported by the system`,
+    "",
+    "// Enemy rows are the top row of each segment, platforms the bottom row",
+    initMacro("ENEMY_ROWS_INIT", enemyRows),
+    initMacro("PLATFORM_ROWS_INIT", platformRows),
+    "",
+    "// Map row of a segment row; arithmetic, so usable from any ROM bank",
+    "#define ENEMY_ROW_Y(row) (PLATFORM_Y_MIN + (row) * SEGMENT_HEIGHT)",
+    "#define PLATFORM_ROW_Y(row) (ENEMY_ROW_Y(row) + SEGMENT_HEIGHT - 1)",
+    "",
+    "// Row and column tests on map coordinates",
+    "#define LEVEL_ROW_OFFSET(y) ((UBYTE)((y) - PLATFORM_Y_MIN))",
+    "#define IS_LEVEL_ROW(y) (LEVEL_ROW_OFFSET(y) < (SEGMENT_ROWS * SEGMENT_HEIGHT))",
+    "#define IS_LEVEL_COLUMN(x) ((UBYTE)((x) - PLATFORM_X_MIN) < PLATFORM_COLUMNS)",
+    "#define IS_ENEMY_ROW(y) (IS_LEVEL_ROW(y) && (LEVEL_ROW_OFFSET(y) % SEGMENT_HEIGHT) == 0)",
+    "#define IS_PLATFORM_ROW(y) (IS_LEVEL_ROW(y) && (LEVEL_ROW_OFFSET(y) % SEGMENT_HEIGHT) == (SEGMENT_HEIGHT - 1))",
+    "// Segment row (0 to SEGMENT_ROWS - 1) of a map row inside the level",
+    "#define SEGMENT_ROW_OF(y) (LEVEL_ROW_OFFSET(y) / SEGMENT_HEIGHT)",
+    "",
+    "// One-bit-per-block masks (UBYTE mask[BLOCK_MASK_BYTES])",
+    "#define BLOCK_MASK_TEST(mask, i) ((mask)[(i) >> 3] & (1 << ((i) & 7)))",
+    "#define BLOCK_MASK_SET(mask, i) ((mask)[(i) >> 3] |= (1 << ((i) & 7)))",
+    "#define BLOCK_MASK_CLEAR(mask, i) ((mask)[(i) >> 3] &= ~(1 << ((i) & 7)))",
+    "",
+    "// The level must fit the MetaTile8 map buffer",
+    "#if defined(MAX_MAP_DATA_WIDTH) && (PLATFORM_X_MAX >= MAX_MAP_DATA_WIDTH)",
+    '#error "level_format.json: level is wider than MAX_MAP_DATA_WIDTH"',
+    "#endif",
+    "#if defined(MAX_MAP_DATA_HEIGHT) && (PLATFORM_Y_MAX >= MAX_MAP_DATA_HEIGHT)",
+    '#error "level_format.json: level is taller than MAX_MAP_DATA_HEIGHT"',
+    "#endif",
+    "",
+    ...SECTION("LEVEL CODE LAYOUT"),
+    `#define LEVEL_CODE_START_X ${spec.level_code.LEVEL_CODE_START_X}`,
+    `#define LEVEL_CODE_START_Y ${spec.level_code.LEVEL_CODE_START_Y}`,
+    "",
+    "// Fixed code: patterns, player column, enemy positions, odd mask, directions",
+    `#define LEVEL_CODE_PLAYER_INDEX ${totalBlocks}`,
+    `#define LEVEL_CODE_ENEMY_INDEX ${codeEnemyIndex}`,
+    `#define LEVEL_CODE_ENEMY_POSITIONS ${codeEnemyPositions}`,
+    `#define LEVEL_CODE_ENEMY_CHARS ${codeEnemyPositions + 2}`,
+    `#define LEVEL_CODE_ODD_MASK_INDEX ${codeEnemyIndex + codeEnemyPositions}`,
+    `#define LEVEL_CODE_DIRECTION_INDEX ${codeEnemyIndex + codeEnemyPositions + 1}`,
+    `#define LEVEL_CODE_CHARS_TOTAL ${codeCharsTotal}`,
+    "",
+    "// On-screen layout: rows of three 4-character groups, one update bit per character",
+    `#define LEVEL_CODE_CHARS_PER_ROW ${CODE_CHARS_PER_ROW}`,
+    `#define LEVEL_CODE_DISPLAY_ROWS ${Math.ceil(codeCharsTotal / CODE_CHARS_PER_ROW)}`,
+    `#define LEVEL_CODE_MASK_BYTES ${Math.ceil(codeCharsTotal / 8)}`,
+    "",
+    "// Enemy position values: 1 + segment row * ENEMY_ANCHORS_PER_ROW + column / 2",
+    `#define ENEMY_ANCHORS_PER_ROW ${anchorsPerRow}`,
+    `#define ENEMY_POS_MAX ${enemyPosMax}`,
+    "",
+    "// 1 when every value of the fixed code fits a single POS41 character;",
+    "// otherwise only the variable-length code round-trips the whole level",
+    `#define LEVEL_CODE_LEGACY ${legacy}`,
+    "",
+    "// Variable-length code: [segments per row, segment rows] patterns",
+    "// [player column hi, lo] [enemy count] then per enemy [row, column hi, lo, direction]",
+    `#define LEVEL_CODE_EXT_HEADER_CHARS ${extHeader}`,
+    `#define LEVEL_CODE_EXT_PLAYER_CHARS ${extPlayerChars}`,
+    `#define LEVEL_CODE_EXT_ENEMY_CHARS ${extEnemyChars}`,
+    `#define LEVEL_CODE_EXT_MIN_CHARS ${extHeader + totalBlocks + extPlayerChars + 1}`,
+    `#define LEVEL_CODE_EXT_MAX_CHARS ${extMax}`,
+    "",
+    "// Platform tile IDs",
+    `#define PLATFORM_TILE_1 ${spec.tiles.TILE_PLATFORM_LEFT}`,
+    `#define PLATFORM_TILE_2 ${spec.tiles.TILE_PLATFORM_MIDDLE}`,
+    `#define PLATFORM_TILE_3 ${spec.tiles.TILE_PLATFORM_RIGHT}`,
+    "",
+    ...SECTION("PLATFORM PATTERNS"),
+    `#define PLATFORM_PATTERN_COUNT ${patterns.length}`,
+    `#define PATTERN_NONE ${hex(PATTERN_NONE)}`,
+    `#define PATTERN_BITS_MASK ${hex((1 << width) - 1)}`,
+    "",
+    `// ${width}-bit row masks, leftmost tile in the high bit`,
+    initMacro("PLATFORM_PATTERNS_INIT", patterns, hex),
+    "",
+    "// Row mask -> pattern ID, PATTERN_NONE for masks no pattern produces",
+    initMacro("PATTERN_FROM_BITS_INIT", fromBits, hex),
+    "",
+    "// Pattern ID -> PATTERN_NEEDS_* flags: a lone tile on the block edge",
+    "// needs a neighbouring block, so the pattern is invalid in that outer column",
+    "#define PATTERN_NEEDS_LEFT 0x01",
+    "#define PATTERN_NEEDS_RIGHT 0x02",
+    initMacro("PATTERN_EDGE_FLAGS_INIT", edgeFlags, hex),
+    "",
+    "// Patterns with a lone tile on the left/right edge (need a neighbour block)",
+    `#define INVALID_PATTERNS_FIRST_COLUMN_COUNT ${invalidFirst.length}`,
+    `#define INVALID_PATTERNS_LAST_COLUMN_COUNT ${invalidLast.length}`,
+    initMacro("INVALID_PATTERNS_FIRST_COLUMN_INIT", invalidFirst),
+    initMacro("INVALID_PATTERNS_LAST_COLUMN_INIT", invalidLast),
+    "",
+    "// Pattern display characters",
+    initMacro("PATTERN_TILE_MAP_INIT", charTiles(spec, patterns.length)),
+    initMacro("EXTENDED_PATTERN_TILE_MAP_INIT", charTiles(spec, spec.chars.pattern_chars)),
+    "",
+    ...SECTION("PREDEFINED LEVELS"),
+    "// Fixed level codes, LEVEL_CODE_CHARS_TOTAL values per row",
+    `#define PREDEFINED_LEVEL_COUNT ${levels.length}`,
+    `#define PREDEFINED_LEVELS_INIT { \\\n${predefinedRows.join(", \\\n")} \\\n}`,
+    "",
+    "#endif // LEVEL_FORMAT_H",
+    "",
+  ].join("\n");
+};
+
+const main = () => {
+  const check = process.argv.includes("--check");
+  const spec = JSON.parse(fs.readFileSync(SPEC, "utf8"));
+  const outputs = {
+    "engine/include/level_tiles.h": buildTiles(spec),
+    "engine/include/level_format.h": buildFormat(spec),
+  };
+  let stale = 0;
+  for (const plugin of PLUGINS) {
+    for (const [name, text] of Object.entries(outputs)) {
+      const rel = `${plugin}/${name}`;
+      const file = path.join(ROOT, rel);
+      const current = fs.existsSync(file) ? fs.readFileSync(file, "utf8") : null;
+      if (current === text) continue;
+      if (check) {
+        console.error(`gen_level_format: ${rel} is out of date`);
+        stale++;
+      } else {
+        fs.writeFileSync(file, text);
+        console.log(`gen_level_format: wrote ${rel}`);
+      }
+    }
+  }
+  if (stale) process.exit(1);
+};
+
+main();
@@ -0,0 +1,251 @@
+#!/usr/bin/env node
+// Reader for the VM profiler ring (EngineCorePlugin, VM_PROFILER = On).
+//
+//   node tools/vm_profile/vm_profile.js game.sav                      opcode/context/native summary
+//   node tools/vm_profile/vm_profile.js game.sav --noi build/rom/game.noi
+//                                                                     also name regions and natives
+//   node tools/vm_profile/vm_profile.js game.sav --bank 3 --top 20 --json
+//
+// The ring sits at the start of SRAM bank VM_PROFILER_SRAM_BANK, so in a .sav
+// dump it starts at bank * 0x2000. Every record holds VM_PROFILE_PERIOD
+// frames; all records are summed. With a .noi symbol file, bytecode regions
+// are resolved to the nearest script symbol in their bank and then to the
+// project resource (script, scene, actor, trigger) carrying that symbol, and
+// native call targets are resolved to C function names.
+
+const fs = require("fs");
+const path = require("path");
+
+const ROOT = path.resolve(__dirname, "..", "..");
+const PROJECT = path.join(ROOT, "project");
+const INSTRUCTIONS = path.join(ROOT, "_reference", "engine", "src", "core", "vm_instructions.c");
+
+// Must match include/vm_profiler.h
+const SRAM_BANK_SIZE = 0x2000;
+const MAGIC = "VMP1";
+const OPCODES = 0x90;
+const CONTEXTS = 16;
+const REGIONS = 64;
+const NATIVES = 16;
+const SITE_SIZE = 5;
+const HEADER_SIZE = 10;
+const RECORD_SIZE = 6 + OPCODES * 2 + CONTEXTS * 2 + (REGIONS + NATIVES) * SITE_SIZE;
+
+const arg = (args, name, fallback) => {
+  const i = args.indexOf(name);
+  return i >= 0 ? args[i + 1] : fallback;
+};
+
+const hex = (n, width = 4) => `0x${n.toString(16).toUpperCase().padStart(width, "0")}`;
+
+// Opcode names from the script_cmds[] table comments: {vm_xxx, BANK(...), n}, // 0xNN
+const loadOpcodeNames = () => {
+  // opcode 0 ends the script; VM_STEP never dispatches it
+  const names = ["vm_stop"];
+  const src = fs.readFileSync(INSTRUCTIONS, "utf8");
+  const re = /\{\s*(vm_\w+)\s*,[^}]*\}\s*,?\s*\/\/\s*0x([0-9A-Fa-f]+)/g;
+  let m;
+  while ((m = re.exec(src))) names[parseInt(m[2], 16)] = m[1];
+  return names;
+};
+
+const readSites = (buf, offset, count) => {
+  const sites = [];
+  for (let i = 0; i < count; i++, offset += SITE_SIZE) {
+    const bank = buf.readUInt8(offset);
+    if (bank === 0) continue;
+    sites.push({ bank, addr: buf.readUInt16LE(offset + 1), count: buf.readUInt16LE(offset + 3) });
+  }
+  return sites;
+};
+
+const readRing = (buf, bank) => {
+  const base = bank * SRAM_BANK_SIZE;
+  if (buf.length < base + HEADER_SIZE) throw new Error(`save has no SRAM bank ${bank}`);
+  if (buf.toString("latin1", base, base + 4) !== MAGIC) throw new Error(`no profiler ring in SRAM bank ${bank}`);
+  const recordSize = buf.readUInt16LE(base + 4);
+  if (recordSize !== RECORD_SIZE) throw new Error(`record size ${recordSize}, expected ${RECORD_SIZE}; tool and engine out of sync`);
+  const recordCount = buf.readUInt8(base + 6);
+  const records = [];
+  for (let r = 0; r < recordCount; r++) {
+    let o = base + HEADER_SIZE + r * RECORD_SIZE;
+    const rec = { frames: buf.readUInt16LE(o), steps: buf.readUInt16LE(o + 2), dropped: buf.readUInt16LE(o + 4) };
+    o += 6;
+    rec.opcodes = [];
+    for (let i = 0; i < OPCODES; i++, o += 2) rec.opcodes.push(buf.readUInt16LE(o));
+    rec.contexts = [];
+    for (let i = 0; i < CONTEXTS; i++, o += 2) rec.contexts.push(buf.readUInt16LE(o));
+    rec.regions = readSites(buf, o, REGIONS);
+    rec.natives = readSites(buf, o + REGIONS * SITE_SIZE, NATIVES);
+    if (rec.frames) records.push(rec);
+  }
+  return records;
+};
+
+const addSites = (map, sites) => {
+  for (const s of sites) {
+    const key = `${s.bank}:${s.addr}`;
+    const row = map.get(key) || { bank: s.bank, addr: s.addr, count: 0 };
+    row.count += s.count;
+    map.set(key, row);
+  }
+};
+
+const summarize = (records) => {
+  const total = { frames: 0, steps: 0, dropped: 0, opcodes: new Array(OPCODES).fill(0), contexts: new Array(CONTEXTS).fill(0) };
+  const regions = new Map();
+  const natives = new Map();
+  for (const rec of records) {
+    total.frames += rec.frames;
+    total.steps += rec.steps;
+    total.dropped += rec.dropped;
+    rec.opcodes.forEach((n, i) => (total.opcodes[i] += n));
+    rec.contexts.forEach((n, i) => (total.contexts[i] += n));
+    addSites(regions, rec.regions);
+    addSites(natives, rec.natives);
+  }
+  const byCount = (a, b) => b.count - a.count;
+  total.regions = [...regions.values()].sort(byCount);
+  total.natives = [...natives.values()].sort(byCount);
+  return total;
+};
+
+// .noi lines are "DEF <symbol> <address>". Banked symbols either carry the
+// bank in bits 16+ of the address or have a b_<name> / ___bank_<name> companion.
+const loadSymbols = (file) => {
+  const defs = new Map();
+  for (const line of fs.readFileSync(file, "utf8").split(/\r?\n/)) {
+    const m = /^DEF\s+(\S+)\s+0x([0-9A-Fa-f]+)/.exec(line);
+    if (m) defs.set(m[1], parseInt(m[2], 16));
+  }
+  const byBank = new Map();
+  for (const [sym, value] of defs) {
+    if (!sym.startsWith("_") || sym.startsWith("___bank_")) continue;
+    const name = sym.slice(1);
+    let bank = value >>> 16;
+    const addr = value & 0xffff;
+    if (!bank) bank = defs.get(`b_${sym}`) ?? defs.get(`b${sym}`) ?? defs.get(`___bank_${name}`) ?? 0;
+    if (!byBank.has(bank)) byBank.set(bank, []);
+    byBank.get(bank).push({ name, addr });
+  }
+  for (const list of byBank.values()) list.sort((a, b) => a.addr - b.addr);
+  return byBank;
+};
+
+const nearestSymbol = (symbols, bank, addr) => {
+  const list = symbols && symbols.get(bank);
+  if (!list) return null;
+  let best = null;
+  for (const s of list) {
+    if (s.addr > addr) break;
+    best = s;
+  }
+  return best && { name: best.name, offset: addr - best.addr };
+};
+
+// Project resources by compiled symbol, with the events they use
+const loadResources = () => {
+  const resources = [];
+  const walk = (dir) => {
+    if (!fs.existsSync(dir)) return;
+    for (const entry of fs.readdirSync(dir, { withFileTypes: true })) {
+      const full = path.join(dir, entry.name);
+      if (entry.isDirectory()) walk(full);
+      else if (entry.name.endsWith(".gbsres")) {
+        let json;
+        try {
+          json = JSON.parse(fs.readFileSync(full, "utf8"));
+        } catch (e) {
+          continue;
+        }
+        const events = new Set();
+        const collect = (node) => {
+          if (Array.isArray(node)) node.forEach(collect);
+          else if (node && typeof node === "object") {
+            if (typeof node.command === "string") events.add(node.command);
+            Object.values(node).forEach(collect);
+          }
+        };
+        collect(json);
+        const add = (res, type) => {
+          if (res && typeof res.symbol === "string") {
+            resources.push({ symbol: res.symbol, name: res.name || res.symbol, type, file: path.relative(ROOT, full), events: [...events] });
+          }
+        };
+        add(json, json._resourceType || "resource");
+        if (Array.isArray(json.actors)) json.actors.forEach((a) => add(a, "actor"));
+        if (Array.isArray(json.triggers)) json.triggers.forEach((t) => add(t, "trigger"));
+      }
+    }
+  };
+  walk(PROJECT);
+  // longest symbol first so scene_1_actor_0 beats scene_1
+  return resources.sort((a, b) => b.symbol.length - a.symbol.length);
+};
+
+const resourceFor = (resources, symbol) => symbol && resources.find((r) => symbol === r.symbol || symbol.startsWith(`${r.symbol}_`));
+
+const main = () => {
+  const args = process.argv.slice(2);
+  const sav = args.find((a, i) => !a.startsWith("--") && (i === 0 || !args[i - 1].startsWith("--")));
+  if (!sav) {
+    console.error("usage: vm_profile.js <game.sav> [--noi game.noi] [--bank 3] [--top 16] [--json]");
+    process.exit(1);
+  }
+  const bank = parseInt(arg(args, "--bank", "3"), 10);
+  const top = parseInt(arg(args, "--top", "16"), 10);
+  const noi = arg(args, "--noi", null);
+
+  let records;
+  try {
+    records = readRing(fs.readFileSync(sav), bank);
+  } catch (e) {
+    console.error(`vm_profile: ${e.message}`);
+    process.exit(1);
+  }
+  const total = summarize(records);
+  const opNames = loadOpcodeNames();
+  const symbols = noi ? loadSymbols(noi) : null;
+  const resources = loadResources();
+
+  const opcodes = total.opcodes
+    .map((count, op) => ({ op, name: opNames[op] || (op === OPCODES - 1 ? "(out of table)" : "?"), count }))
+    .filter((r) => r.count)
+    .sort((a, b) => b.count - a.count);
+  const contexts = total.contexts.map((count, i) => ({ id: i + 1, count })).filter((r) => r.count).sort((a, b) => b.count - a.count);
+  const regions = total.regions.map((r) => {
+    const sym = nearestSymbol(symbols, r.bank, r.addr);
+    const res = resourceFor(resources, sym && sym.name);
+    return { ...r, symbol: sym, resource: res ? { name: res.name, type: res.type, file: res.file, events: res.events } : null };
+  });
+  const natives = total.natives.map((r) => ({ ...r, symbol: nearestSymbol(symbols, r.bank, r.addr) }));
+
+  if (args.includes("--json")) {
+    console.log(JSON.stringify({ frames: total.frames, steps: total.steps, dropped: total.dropped, opcodes, contexts, regions, natives }, null, 2));
+    return;
+  }
+
+  const pct = (n) => `${((100 * n) / Math.max(total.steps, 1)).toFixed(1).padStart(5)}%`;
+  console.log(`${records.length} records, ${total.frames} frames, ${total.steps} instructions (${(total.steps / Math.max(total.frames, 1)).toFixed(1)}/frame), ${total.dropped} unplaced sites`);
+
+  console.log("\nopcodes");
+  for (const r of opcodes.slice(0, top)) console.log(`${String(r.count).padStart(7)} ${pct(r.count)}  ${hex(r.op, 2)} ${r.name}`);
+
+  console.log("\ncontexts");
+  for (const r of contexts) console.log(`${String(r.count).padStart(7)} ${pct(r.count)}  thread ${r.id}`);
+
+  console.log("\nbytecode regions");
+  for (const r of regions.slice(0, top)) {
+    const where = r.symbol ? `${r.symbol.name}+${r.symbol.offset}` : `${r.bank}:${hex(r.addr)}`;
+    const res = r.resource ? `  ${r.resource.type} "${r.resource.name}" (${r.resource.file}) ${r.resource.events.slice(0, 6).join(", ")}` : "";
+    console.log(`${String(r.count).padStart(7)} ${pct(r.count)}  ${where}${res}`);
+  }
+
+  console.log("\nnative calls");
+  for (const r of natives.slice(0, top)) {
+    const where = r.symbol && r.symbol.offset === 0 ? r.symbol.name : `${r.bank}:${hex(r.addr)}`;
+    console.log(`${String(r.count).padStart(7)}  ${where}`);
+  }
+};
+
+main();